@@ -12,6 +12,8 @@
 
 #include <Eigen/Dense>
 
+#include <admm/gain_design.h>
+
 /// \brief MATLAB generated files. From lib/codegen_admm.
 #include <ADMMGainDesign3D.h>
 #include <ADMMGainDesign3D_terminate.h>
@@ -19,22 +21,41 @@
 #include <ADMMGainDesign3D_emxAPI.h>
 #include <ADMMGainDesign3D_initialize.h>
 
-#include "aclswarm/utils.h"
-
 namespace acl {
 namespace aclswarm {
 
-  class ADMM
+  /**
+   * @brief      Gain design backend of the MATLAB-generated ADMM solver.
+   *
+   *             Inputs and output are mapped into emxArrays without copies.
+   *             The solver runs to its own stopping criteria and only
+   *             reports that it converged.
+   */
+  class ADMM : public admm::GainDesign
   {
   public:
-    ADMM(const size_t n);
+    ADMM();
     ~ADMM();
-    
-    GainMat calculateFormationGains(const PtsMat& p, const AdjMat& adjmat);
+
+    const char * name() const override { return "codegen"; }
+
+    /**
+     * @brief      Designs the gains (see GainDesign::solve). The generated
+     *             code cannot be interrupted, so there is no time budget.
+     *
+     * @throws     std::invalid_argument  If given a deadline, i.e., > 0
+     */
+    Eigen::MatrixXd solve(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) override;
+
+    Eigen::MatrixXd calculateFormationGains(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj);
 
   private:
-    /// \brief MATLAB 2D emxArray container
-    emxArray_real_T * Aopt_; ///< resulting 3nx3n gain matrix
+    Eigen::MatrixXd A_; ///< resulting 3nx3n gain matrix, written by MATLAB
 
     void emxPrint(emxArray_real_T * emx);
   };
@@ -21,11 +21,12 @@
 #include <snapstack_msgs/State.h>
 #include <aclswarm_msgs/CBAA.h>
 #include <aclswarm_msgs/Formation.h>
+#include <aclswarm_msgs/FormationGains.h>
 #include <aclswarm_msgs/VehicleEstimates.h>
 #include <geometry_msgs/Vector3Stamped.h>
 #include <std_msgs/UInt8MultiArray.h>
 
-#include <admm/solver.h>
+#include <admm/gain_design.h>
 #include "aclswarm/distcntrl.h"
 #include "aclswarm/auctioneer.h"
 #include "aclswarm/utils.h"
@@ -48,6 +49,7 @@ namespace aclswarm {
     ros::Timer tim_auctioneer_, tim_autoauction_, tim_control_;
     ros::Subscriber sub_formation_, sub_tracker_, sub_central_assignment_;
     ros::Publisher pub_distcmd_, pub_assignment_, pub_cbaabid_;
+    ros::ServiceClient gain_client_;
 
     uint8_t n_; ///< number of vehicles in swarm
     uint8_t vehid_; ///< ID of vehicle (index in veh named list)
@@ -55,7 +57,7 @@ namespace aclswarm {
     std::vector<std::string> vehs_; ///< list of all vehicles in swarm
 
     /// \brief Modules
-    std::unique_ptr<admm::Solver> admm_; ///< module for 3D gain design
+    std::unique_ptr<admm::GainDesign> admm_; ///< module for 3D gain design
     std::unique_ptr<DistCntrl> controller_; ///< module for control task
     std::unique_ptr<Auctioneer> auctioneer_; ///< module for assignment task
 
@@ -78,6 +80,9 @@ namespace aclswarm {
     double auctioneer_dt_; ///< period at which rcvd bids are processed
     double autoauction_dt_; ///< period of auto auctions (btwn form rcvd)
     double control_dt_; ///< period of high-level distributed control task
+    double admm_deadline_; ///< time budget of gain design (ms), 0 for none
+    std::string gain_server_; ///< gain server service, empty to always solve
+    double gain_server_timeout_; ///< how long to wait for the server (s)
 
     /**
      * @brief      Initialize control and assignment modules with rosparams
@@ -93,6 +98,17 @@ namespace aclswarm {
 
     void sendZeroControl();
 
+    /**
+     * @brief      Requests the gains of a formation registered at the gain
+     *             server by the operator (i.e., with a nonzero gainsHash)
+     *
+     * @param      formation  The formation, whose gains are set on success
+     *
+     * @return     False if the formation is not registered or the server is
+     *             unavailable (i.e., solve locally)
+     */
+    bool requestGains(DistCntrl::Formation& formation);
+
     /// \brief ROS callback handlers
     void formationCb(const aclswarm_msgs::FormationConstPtr& msg);
     void vehicleTrackerCb(const aclswarm_msgs::VehicleEstimatesConstPtr& msg);
@@ -15,6 +15,7 @@
 
 #include <Eigen/Dense>
 
+#include <admm/block_gain_mat.h>
 #include "aclswarm/utils.h"
 
 namespace acl {
@@ -26,8 +27,9 @@ namespace aclswarm {
     struct Formation {
       std::string name; ///< name of current formation
       AdjMat adjmat; ///< current adjacency matrix for formation (nxn)
-      GainMat gains; ///< gains for the current formation (3xn3x)
+      admm::BlockGainMat gains; ///< gains for the current formation (3nx3n)
       PtsMat qdes; ///< desired 3D positions of swarm (nx3)
+      uint64_t gainsHash = 0; ///< key of the gains at the gain server, or 0
 
       Eigen::MatrixXd dstar_xy; ///< desired 2D scale (derived from qdes)
       Eigen::MatrixXd dstar_z; ///< desired z scale (derived from qdes)
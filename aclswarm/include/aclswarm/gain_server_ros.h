@@ -0,0 +1,71 @@
+/**
+ * @file gain_server_ros.h
+ * @brief ROS wrapper for gain design shared by the swarm
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+#include <ros/ros.h>
+
+#include <aclswarm_msgs/FormationGains.h>
+
+#include <admm/block_gain_mat.h>
+#include <admm/gain_design.h>
+#include "aclswarm/utils.h"
+
+namespace acl {
+namespace aclswarm {
+
+  /**
+   * @brief      Designs the gains of each formation once for the whole swarm.
+   *
+   *             The operator and every coordination node request the gains
+   *             of a formation by its hash (see utils::hashFormation), so a
+   *             formation change is solved once instead of on each vehicle.
+   */
+  class GainServerROS
+  {
+  public:
+    GainServerROS(const ros::NodeHandle nh, const ros::NodeHandle nhp);
+    ~GainServerROS() = default;
+
+  private:
+    ros::NodeHandle nh_, nhp_;
+    ros::ServiceServer srv_gains_;
+
+    /// \brief Modules
+    std::unique_ptr<admm::GainDesign> admm_; ///< module for 3D gain design
+
+    /// \brief Designed gains, keyed by formation hash (most recent first)
+    using CacheOrder = std::list<uint64_t>;
+    std::unordered_map<uint64_t,
+                std::pair<admm::BlockGainMat, CacheOrder::iterator>> cache_;
+    CacheOrder order_;
+
+    /// \brief Parameters
+    size_t cache_size_; ///< max number of cached formations
+    double admm_deadline_; ///< time budget of gain design (ms), 0 for none
+
+    /**
+     * @brief      Looks up (and refreshes) the gains of a formation
+     *
+     * @return     The gains, or nullptr if not cached
+     */
+    const admm::BlockGainMat * lookup(uint64_t hash);
+
+    void insert(uint64_t hash, const admm::BlockGainMat& gains);
+
+    bool gainsCb(aclswarm_msgs::FormationGains::Request& req,
+                  aclswarm_msgs::FormationGains::Response& res);
+  };
+
+} // ns aclswarm
+} // ns acl
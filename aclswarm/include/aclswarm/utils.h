@@ -8,6 +8,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <numeric>
 #include <string>
 #include <vector>
@@ -127,6 +128,36 @@ static GainMat decodeGainMat(const std_msgs::Float32MultiArray& msg)
 
 // ----------------------------------------------------------------------------
 
+/**
+ * @brief      Hash of a formation (FNV-1a of its points and graph). Every
+ *             vehicle receives the same formation msg, so they all agree.
+ *
+ * @param[in]  qdes    The nx3 desired formation points
+ * @param[in]  adjmat  The nxn formation graph
+ *
+ * @return     The hash, never 0 (which means 'unknown' in msgs)
+ */
+static uint64_t hashFormation(const PtsMat& qdes, const AdjMat& adjmat)
+{
+  uint64_t h = 14695981039346656037ULL;
+  auto mix = [&h](const void * data, size_t bytes) {
+    const uint8_t * p = static_cast<const uint8_t *>(data);
+    for (size_t k=0; k<bytes; ++k) {
+      h ^= p[k];
+      h *= 1099511628211ULL;
+    }
+  };
+
+  const uint64_t n = qdes.rows();
+  mix(&n, sizeof(n));
+  mix(qdes.data(), qdes.size() * sizeof(double));
+  mix(adjmat.data(), adjmat.size() * sizeof(vehidx_t));
+
+  return (h == 0) ? 1 : h;
+}
+
+// ----------------------------------------------------------------------------
+
 /**
  * @brief      Compute distance matrix
  *
@@ -0,0 +1,78 @@
+/**
+ * @file batch.cpp
+ * @brief Benchmark of batch gain design on a pool of worker threads
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <admm/batch_solver.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+int batch(int argc, char *argv[])
+{
+  size_t count = 32, nmin = 6, nmax = 15;
+  size_t maxWorkers = std::thread::hardware_concurrency();
+  double density = 0.5;
+  for (int i=0; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--count") && i+1 < argc) count = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--nmin") && i+1 < argc) nmin = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--nmax") && i+1 < argc) nmax = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--workers") && i+1 < argc) maxWorkers = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--density") && i+1 < argc) density = std::atof(argv[++i]);
+    else {
+      std::cerr << "usage: admm-bench batch [--count N] [--nmin N] [--nmax N] "
+                   "[--workers N] [--density p]" << std::endl;
+      return 1;
+    }
+  }
+  maxWorkers = std::max<size_t>(maxWorkers, 1);
+
+  // random formations of random size, as generated for a sim campaign
+  std::vector<BatchSolver::Problem> problems;
+  for (size_t k=0; k<count; ++k) {
+    const size_t n = nmin + k % (nmax - nmin + 1);
+    const Formation f = randomFormation(n, density, k);
+    problems.push_back({f.pts, f.adj});
+  }
+
+  std::printf("%8s %12s %10s %10s\n", "workers", "ms", "speedup", "max diff");
+
+  std::vector<Eigen::MatrixXd> reference;
+  double t1 = 0;
+  for (size_t w=1; w<=maxWorkers; w*=2) {
+    BatchSolver solver(Params(), w);
+
+    const auto tstart = std::chrono::steady_clock::now();
+    const auto gains = solver.solve(problems);
+    const double t = elapsedMs(tstart);
+    if (w == 1) { t1 = t; reference = gains; }
+
+    double maxDiff = 0;
+    for (size_t k=0; k<gains.size(); ++k) {
+      maxDiff = std::max(maxDiff,
+                          (gains[k] - reference[k]).cwiseAbs().maxCoeff());
+    }
+
+    std::printf("%8zu %12.1f %10.2f %10.1e\n", w, t, t1 / t, maxDiff);
+  }
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,81 @@
+/**
+ * @file bench.h
+ * @brief Benchmarks for ADMM-based formation gain solver
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <admm/telemetry.h>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+  /**
+   * @brief      A gain design problem, i.e., formation points and graph
+   */
+  struct Formation {
+    std::string group; ///< name of formation group (e.g., 'swarm4')
+    std::string name; ///< name of formation within group
+    Eigen::Matrix<double, 3, Eigen::Dynamic> pts; ///< 3xn formation points
+    Eigen::MatrixXd adj; ///< nxn adjacency matrix of formation graph
+  };
+
+  /**
+   * @brief      Loads formations from a formation group file (formations.yaml)
+   *
+   *             Follows the conventions of nodes/operator.py: a group-level
+   *             adjmat overrides formation-level ones and anything that is
+   *             not a matrix (e.g., 'fc') means fully connected.
+   *
+   * @param[in]  file           The formations yaml file
+   * @param[in]  groups         Groups to load (empty to load all groups)
+   * @param[in]  formationAdj   Prefer formation-level over group-level adjmat
+   *
+   * @return     The formations of the requested groups, in file order
+   */
+  std::vector<Formation> loadFormations(const std::string& file,
+                                        const std::vector<std::string>& groups,
+                                        bool formationAdj = false);
+
+  /**
+   * @brief      A random formation in a 20m x 20m x 2m box. The graph is a
+   *             ring plus every other edge with probability density.
+   */
+  Formation randomFormation(size_t n, double density, unsigned int seed);
+
+  using telemetry::elapsedMs;
+
+  /**
+   * @brief      Gain quality: the smallest nonzero eigenvalue of -A, taken
+   *             over the xy and z parts of the gain matrix. The designed
+   *             \bar{A} has unit mean eigenvalue, so larger is better.
+   *
+   * @param[in]  A     Dense gain matrix (3n x 3n)
+   */
+  double minNonzeroEig(const Eigen::MatrixXd& A);
+
+  /// \brief Benchmark entry points (admm-bench <name> ...)
+  int factorCache(int argc, char *argv[]);
+  int accel(int argc, char *argv[]);
+  int dimKernels(int argc, char *argv[]);
+  int batch(int argc, char *argv[]);
+  int scaling(int argc, char *argv[]);
+  int equilibrate(int argc, char *argv[]);
+  int portfolio(int argc, char *argv[]);
+  int lowRank(int argc, char *argv[]);
+  int parity(int argc, char *argv[]); ///< only with ADMM_BENCH_CODEGEN
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,99 @@
+/**
+ * @file dim_kernels.cpp
+ * @brief Benchmark of constraint construction specialized on the ambient
+ *        dimension (d = 1, 2) vs. taking it at runtime
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+
+#include <admm/solver.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+/**
+ * @brief      Accumulates parse and per-iteration times over solves
+ */
+struct Timing {
+  double tParse = 0; ///< ms
+  double tItr = 0; ///< ms
+  size_t iterations = 0;
+
+  void operator()(const Telemetry& tel) {
+    tParse += tel.tParse;
+    for (const auto& it : tel.iterations) {
+      tItr += it.tY + it.tEig + it.tUpdate + it.tStop;
+    }
+    iterations += tel.iterations.size();
+  }
+};
+
+// ----------------------------------------------------------------------------
+
+int dimKernels(int argc, char *argv[])
+{
+  size_t nmin = 4, nmax = 30, reps = 3;
+  double density = 0.5;
+  for (int i=0; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--nmin") && i+1 < argc) nmin = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--nmax") && i+1 < argc) nmax = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--reps") && i+1 < argc) reps = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--density") && i+1 < argc) density = std::atof(argv[++i]);
+    else {
+      std::cerr << "usage: admm-bench dim-kernels [--nmin N] [--nmax N] "
+                   "[--reps N] [--density p]" << std::endl;
+      return 1;
+    }
+  }
+
+  // n.b., only the parse is specialized. Per-iteration time is a control,
+  // i.e., it should not change.
+  std::printf("%4s %14s %14s %8s %14s %14s %8s %10s\n", "n",
+              "parse dyn ms", "parse spec ms", "speedup",
+              "itr dyn ms", "itr spec ms", "speedup", "max diff");
+
+  for (size_t n=nmin; n<=nmax; ++n) {
+    const Formation f = randomFormation(n, density, n);
+
+    Timing dyn, spec;
+    Params params;
+    params.specializeDim = false;
+    params.telemetry = std::ref(dyn);
+    Solver solverDyn(params);
+    params.specializeDim = true;
+    params.telemetry = std::ref(spec);
+    Solver solverSpec(params);
+
+    double maxDiff = 0;
+    for (size_t r=0; r<reps; ++r) {
+      const Eigen::MatrixXd Ad = solverDyn.solve(f.pts, f.adj);
+      const Eigen::MatrixXd As = solverSpec.solve(f.pts, f.adj);
+      maxDiff = std::max(maxDiff, (Ad - As).cwiseAbs().maxCoeff());
+    }
+
+    // per solve (both subproblems) and per iteration
+    const double pd = dyn.tParse / reps, ps = spec.tParse / reps;
+    const double id = dyn.tItr / dyn.iterations;
+    const double is = spec.tItr / spec.iterations;
+    std::printf("%4zu %14.3f %14.3f %8.2f %14.3f %14.3f %8.2f %10.1e\n", n,
+                pd, ps, pd / ps, id, is, id / is, maxDiff);
+  }
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
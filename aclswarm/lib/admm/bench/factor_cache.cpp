@@ -0,0 +1,95 @@
+/**
+ * @file factor_cache.cpp
+ * @brief Benchmark of reusing the symbolic factorization of A*A'
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <admm/solver.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+int factorCache(int argc, char *argv[])
+{
+  if (argc < 1) {
+    std::cerr << "usage: admm-bench factor-cache <formations.yaml> "
+                 "[--reps N] [--group-adjmat] [group ...]" << std::endl;
+    return 1;
+  }
+
+  const std::string file = argv[0];
+  size_t reps = 10;
+  bool formationAdj = true;
+  std::vector<std::string> groups;
+  for (int i=1; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--reps") && i+1 < argc) reps = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--group-adjmat")) formationAdj = false;
+    else groups.push_back(argv[i]);
+  }
+  // n.b., formation-level graphs by default, since the group-level ones are
+  // all fully connected
+  if (groups.empty()) groups = {"swarm6", "swarm6_3d"};
+
+  const auto formations = loadFormations(file, groups, formationAdj);
+
+  // n.b., without the closed form, fully connected formations iterate too
+  Params params;
+  params.closedForm = false;
+  params.cacheFactorization = false;
+  Solver uncached(params);
+  params.cacheFactorization = true;
+  Solver cached(params);
+
+  // Formations are solved in file order, as if an operator stepped through
+  // the group. Only the first solve of a new graph needs symbolic analysis.
+  std::vector<double> tUncached(formations.size(), 0.0);
+  std::vector<double> tCached(formations.size(), 0.0);
+  for (size_t r=0; r<reps; ++r) {
+    for (size_t k=0; k<formations.size(); ++k) {
+      const auto& f = formations[k];
+
+      auto start = std::chrono::steady_clock::now();
+      uncached.solve(f.pts, f.adj);
+      tUncached[k] += elapsedMs(start);
+
+      start = std::chrono::steady_clock::now();
+      cached.solve(f.pts, f.adj);
+      tCached[k] += elapsedMs(start);
+    }
+  }
+
+  std::printf("%-10s %-20s %4s %12s %12s %12s\n", "group", "formation", "n",
+              "uncached ms", "cached ms", "saved ms");
+
+  double totUncached = 0, totCached = 0;
+  for (size_t k=0; k<formations.size(); ++k) {
+    const auto& f = formations[k];
+    const double tu = tUncached[k] / reps;
+    const double tc = tCached[k] / reps;
+    totUncached += tu;
+    totCached += tc;
+    std::printf("%-10s %-20s %4ld %12.3f %12.3f %12.3f\n", f.group.c_str(),
+                f.name.c_str(), f.pts.cols(), tu, tc, tu - tc);
+  }
+
+  std::printf("total: %.3f ms uncached, %.3f ms cached, %.1f%% saved\n",
+              totUncached, totCached,
+              100.0 * (totUncached - totCached) / totUncached);
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,109 @@
+/**
+ * @file formations.cpp
+ * @brief Loads formation groups for benchmarks of the gain design solver
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <random>
+
+#include <yaml-cpp/yaml.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+static Eigen::MatrixXd parseMatrix(const YAML::Node& node, size_t cols)
+{
+  Eigen::MatrixXd M(node.size(), cols);
+  for (size_t i=0; i<node.size(); ++i) {
+    for (size_t j=0; j<cols; ++j) {
+      M(i,j) = node[i][j].as<double>();
+    }
+  }
+  return M;
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<Formation> loadFormations(const std::string& file,
+                                      const std::vector<std::string>& groups,
+                                      bool formationAdj)
+{
+  std::vector<Formation> formations;
+
+  const YAML::Node root = YAML::LoadFile(file);
+  for (const auto& kv : root) {
+    const std::string group = kv.first.as<std::string>();
+    const YAML::Node& g = kv.second;
+
+    if (!groups.empty() &&
+        std::find(groups.begin(), groups.end(), group) == groups.end()) {
+      continue;
+    }
+
+    const size_t n = g["agents"].as<size_t>();
+    const Eigen::MatrixXd fc = Eigen::MatrixXd::Ones(n, n)
+                              - Eigen::MatrixXd::Identity(n, n);
+
+    for (const auto& f : g["formations"]) {
+      Formation formation;
+      formation.group = group;
+      formation.name = f["name"].as<std::string>();
+
+      const double scale = (f["scale"]) ? f["scale"].as<double>() : 1.0;
+      formation.pts = scale * parseMatrix(f["points"], 3).transpose();
+
+      // group adjmat takes precedence, unless asked otherwise
+      YAML::Node adj = g["adjmat"];
+      if (formationAdj && f["adjmat"] && f["adjmat"].IsSequence()) {
+        adj = f["adjmat"];
+      }
+      formation.adj = (adj && adj.IsSequence()) ? parseMatrix(adj, n) : fc;
+
+      formations.push_back(formation);
+    }
+  }
+
+  return formations;
+}
+
+// ----------------------------------------------------------------------------
+
+Formation randomFormation(size_t n, double density, unsigned int seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> xy(-10.0, 10.0);
+  std::uniform_real_distribution<double> z(1.0, 3.0);
+  std::bernoulli_distribution edge(density);
+
+  Formation formation;
+  formation.group = "random";
+  formation.name = "n" + std::to_string(n) + "_s" + std::to_string(seed);
+
+  formation.pts.resize(3, n);
+  for (size_t i=0; i<n; ++i) {
+    formation.pts.col(i) << xy(gen), xy(gen), z(gen);
+  }
+
+  // a ring keeps the graph connected, other edges are random
+  formation.adj = Eigen::MatrixXd::Zero(n, n);
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=i+1; j<n; ++j) {
+      if (j == i+1 || (i == 0 && j == n-1) || edge(gen)) {
+        formation.adj(i,j) = formation.adj(j,i) = 1;
+      }
+    }
+  }
+
+  return formation;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
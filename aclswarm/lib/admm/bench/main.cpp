@@ -0,0 +1,52 @@
+/**
+ * @file main.cpp
+ * @brief Entry point for benchmarks of the ADMM-based formation gain solver
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cstring>
+#include <iostream>
+
+#include "bench.h"
+
+using namespace acl::aclswarm::admm;
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2) {
+    std::cerr << "usage: admm-bench <benchmark> [args...]" << std::endl;
+    std::cerr << "benchmarks: factor-cache, accel, dim-kernels, batch, scaling, "
+                 "equilibrate, portfolio, low-rank";
+#ifdef ADMM_BENCH_CODEGEN
+    std::cerr << ", parity";
+#endif
+    std::cerr << std::endl;
+    return 1;
+  }
+
+  if (!std::strcmp(argv[1], "factor-cache")) {
+    return bench::factorCache(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "accel")) {
+    return bench::accel(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "dim-kernels")) {
+    return bench::dimKernels(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "batch")) {
+    return bench::batch(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "scaling")) {
+    return bench::scaling(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "equilibrate")) {
+    return bench::equilibrate(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "portfolio")) {
+    return bench::portfolio(argc-2, argv+2);
+  } else if (!std::strcmp(argv[1], "low-rank")) {
+    return bench::lowRank(argc-2, argv+2);
+#ifdef ADMM_BENCH_CODEGEN
+  } else if (!std::strcmp(argv[1], "parity")) {
+    return bench::parity(argc-2, argv+2);
+#endif
+  }
+
+  std::cerr << "unknown benchmark '" << argv[1] << "'" << std::endl;
+  return 1;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file parity.cpp
+ * @brief Benchmark of the gain design backends against each other
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#include <admm/solver.h>
+#include <aclswarm/admm.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+int parity(int argc, char *argv[])
+{
+  if (argc < 1) {
+    std::cerr << "usage: admm-bench parity <formations.yaml> "
+                 "[--reps N] [--formation-adjmat] [group ...]" << std::endl;
+    return 1;
+  }
+
+  const std::string file = argv[0];
+  size_t reps = 3;
+  bool formationAdj = false;
+  std::vector<std::string> groups;
+  for (int i=1; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--reps") && i+1 < argc) reps = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--formation-adjmat")) formationAdj = true;
+    else groups.push_back(argv[i]);
+  }
+
+  // all groups, unless asked otherwise
+  const auto formations = loadFormations(file, groups, formationAdj);
+
+  // n.b., default parameters, as used by the coordination node, except for
+  // the closed form, which the codegen backend does not have
+  Params params;
+  params.closedForm = false;
+  std::unique_ptr<GainDesign> backends[2] = {
+    std::unique_ptr<GainDesign>(new Solver(params)),
+    std::unique_ptr<GainDesign>(new ADMM)
+  };
+
+  std::printf("%-10s %-20s %4s %12s %12s %9s %10s %10s %10s\n", "group",
+              "formation", "n", "admm ms", "codegen ms", "speedup",
+              "rel diff", "eig admm", "eig cg");
+
+  double tot[2] = {0, 0};
+  double worstDiff = 0;
+  for (const auto& f : formations) {
+    Eigen::MatrixXd A[2];
+    double t[2] = {0, 0};
+    for (size_t b=0; b<2; ++b) {
+      for (size_t r=0; r<reps; ++r) {
+        GainDesign::Quality quality;
+        const auto start = std::chrono::steady_clock::now();
+        A[b] = backends[b]->solve(f.pts, f.adj, 0, quality);
+        t[b] += elapsedMs(start);
+      }
+      t[b] /= reps;
+      tot[b] += t[b];
+    }
+
+    const double diff = (A[0] - A[1]).norm() / A[1].norm();
+    worstDiff = std::max(worstDiff, diff);
+
+    std::printf("%-10s %-20s %4ld %12.3f %12.3f %9.2f %10.2e %10.4f %10.4f\n",
+                f.group.c_str(), f.name.c_str(), f.pts.cols(), t[0], t[1],
+                t[1] / t[0], diff, minNonzeroEig(A[0]), minNonzeroEig(A[1]));
+  }
+
+  std::printf("total: %.3f ms admm, %.3f ms codegen (%.2fx); worst relative "
+              "difference %.2e\n", tot[0], tot[1], tot[1] / tot[0], worstDiff);
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,116 @@
+/**
+ * @file portfolio.cpp
+ * @brief Benchmark of the latency of a portfolio of solver configurations
+ *        against each configuration on its own
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include <admm/portfolio_solver.h>
+#include <admm/solver.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+int portfolio(int argc, char *argv[])
+{
+  if (argc < 1) {
+    std::cerr << "usage: admm-bench portfolio <formations.yaml> "
+                 "[--max-itr N] [--eps E] [--formation-adjmat] "
+                 "[group ...]" << std::endl;
+    return 1;
+  }
+
+  const std::string file = argv[0];
+  size_t maxItr = 500;
+  double eps = 1e-5;
+  bool formationAdj = false;
+  std::vector<std::string> groups;
+  for (int i=1; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--max-itr") && i+1 < argc) maxItr = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--eps") && i+1 < argc) eps = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--formation-adjmat")) formationAdj = true;
+    else groups.push_back(argv[i]);
+  }
+
+  // all groups by default
+  const auto formations = loadFormations(file, groups, formationAdj);
+
+  // run to a residual tolerance, so that how fast a configuration converges
+  // on a formation is what decides its latency. n.b., without the closed
+  // form, so that fully connected formations iterate too.
+  Params base;
+  base.closedForm = false;
+  base.residualStop = true;
+  base.epsPrimal = base.epsDual = eps;
+  base.maxItr = maxItr;
+  const auto configs = PortfolioSolver::configurations(base);
+
+  // n.b., a member that ran out of iterations has not converged
+  PortfolioSolver::Acceptance acceptance;
+  acceptance.maxPrimalRes = acceptance.maxDualRes = eps;
+
+  std::printf("%u hardware threads, %zu configurations\n\n",
+              std::thread::hardware_concurrency(), configs.size());
+  std::printf("%-10s %-20s %4s", "group", "formation", "n");
+  for (size_t c=0; c<configs.size(); ++c) {
+    std::printf("  mu %-4g a %-3g", configs[c].mu, configs[c].alpha);
+  }
+  std::printf(" %10s %6s\n", "portfolio", "winner");
+
+  std::vector<double> worst(configs.size() + 1, 0.0);
+  std::vector<double> total(configs.size() + 1, 0.0);
+  for (const auto& f : formations) {
+    std::printf("%-10s %-20s %4ld", f.group.c_str(), f.name.c_str(),
+                f.pts.cols());
+
+    // each configuration on its own, from a cold start
+    for (size_t c=0; c<configs.size(); ++c) {
+      Solver solver(configs[c]);
+      GainDesign::Quality quality;
+      const auto start = std::chrono::steady_clock::now();
+      solver.solve(f.pts, f.adj, 0, quality);
+      const double ms = elapsedMs(start);
+
+      const bool ok = quality.primalRes <= eps && quality.dualRes <= eps;
+      std::printf(" %13.3f%c", ms, (ok) ? ' ' : '*');
+      worst[c] = std::max(worst[c], ms);
+      total[c] += ms;
+    }
+
+    PortfolioSolver solver(configs, acceptance);
+    GainDesign::Quality quality;
+    const auto start = std::chrono::steady_clock::now();
+    solver.solve(f.pts, f.adj, 0, quality);
+    const double ms = elapsedMs(start);
+
+    std::printf(" %10.3f %6zu\n", ms, solver.winner());
+    worst.back() = std::max(worst.back(), ms);
+    total.back() += ms;
+  }
+
+  std::printf("\n(* did not reach eps within max itr)\n");
+  std::printf("%-36s", "worst ms");
+  for (const double ms : worst) std::printf(" %13.3f ", ms);
+  std::printf("\n%-36s", "total ms");
+  for (const double ms : total) std::printf(" %13.3f ", ms);
+  std::printf("\n");
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,57 @@
+/**
+ * @file quality.cpp
+ * @brief Quality measures of designed gain matrices
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <Eigen/Eigenvalues>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+static double minNonzero(const Eigen::MatrixXd& M)
+{
+  const Eigen::VectorXd ev =
+                  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(M).eigenvalues();
+  const double tol = 1e-6 * std::max(1.0, ev.cwiseAbs().maxCoeff());
+
+  // n.b., the kernel of the gains (formation, rotations, translations)
+  double lmin = std::numeric_limits<double>::infinity();
+  for (int i=0; i<ev.size(); ++i) {
+    if (std::abs(ev(i)) > tol) lmin = std::min(lmin, ev(i));
+  }
+  return lmin;
+}
+
+// ----------------------------------------------------------------------------
+
+double minNonzeroEig(const Eigen::MatrixXd& A)
+{
+  const size_t n = A.rows() / 3;
+
+  // split into the xy and z parts of each 3x3 block
+  std::vector<int> ixy, iz;
+  for (size_t i=0; i<3*n; ++i) ((i % 3 == 2) ? iz : ixy).push_back(i);
+
+  Eigen::MatrixXd Axy(2*n, 2*n), Az(n, n);
+  for (size_t i=0; i<ixy.size(); ++i)
+    for (size_t j=0; j<ixy.size(); ++j) Axy(i,j) = -A(ixy[i], ixy[j]);
+  for (size_t i=0; i<iz.size(); ++i)
+    for (size_t j=0; j<iz.size(); ++j) Az(i,j) = -A(iz[i], iz[j]);
+
+  return std::min(minNonzero(Axy), minNonzero(Az));
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
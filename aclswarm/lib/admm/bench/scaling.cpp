@@ -0,0 +1,246 @@
+/**
+ * @file scaling.cpp
+ * @brief Benchmark of solve time and memory against swarm size and edges
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <admm/solver.h>
+
+#include "bench.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+namespace bench {
+
+namespace {
+
+/**
+ * @brief      Reads a memory field (kB) of /proc/self/status, e.g., VmHWM
+ *
+ * @return     The value, or -1 if not available (e.g., not Linux)
+ */
+long procStatusKb(const std::string& field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, field.size() + 1, field + ":") == 0) {
+      return std::atol(line.c_str() + field.size() + 1);
+    }
+  }
+  return -1;
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief      Resets the peak resident set size (VmHWM) to the current one
+ *
+ * @return     False if the kernel does not support it, i.e., peaks are then
+ *             taken over the lifetime of the process
+ */
+bool resetPeakRss()
+{
+  std::ofstream clear("/proc/self/clear_refs");
+  if (!clear) return false;
+  clear << "5";
+  return static_cast<bool>(clear.flush());
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief      Returns freed heap memory to the OS, so that the RSS before a
+ *             solve does not include what previous (larger) solves left
+ */
+void trimHeap()
+{
+#ifdef __GLIBC__
+  malloc_trim(0);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief      One gain design of the sweep
+ */
+struct Sample {
+  size_t n, edges, rep;
+  double density;
+  size_t dimX = 0, rowsA = 0, nnzA = 0; ///< of the 2D subproblem
+  size_t itr2d = 0, itr1d = 0;
+  double tParse = 0, tFactorize = 0, tY = 0, tEig = 0, tUpdate = 0;
+  double tStop = 0, tProject = 0, tTotal = 0;
+  long rssKb = -1, peakKb = -1; ///< RSS before the solve, peak during it
+};
+
+} // ns
+
+// ----------------------------------------------------------------------------
+
+int scaling(int argc, char *argv[])
+{
+  size_t nmin = 4, nmax = 100, step = 8, reps = 1, maxItr = 0;
+  double maxMs = 60000;
+  std::vector<double> densities;
+  unsigned int seed = 0;
+  std::string format = "csv", out, formulation;
+  bool nullSpace = false;
+  for (int i=0; i<argc; ++i) {
+    if (!std::strcmp(argv[i], "--nmin") && i+1 < argc) nmin = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--nmax") && i+1 < argc) nmax = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--step") && i+1 < argc) step = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--density") && i+1 < argc) densities.push_back(std::atof(argv[++i]));
+    else if (!std::strcmp(argv[i], "--reps") && i+1 < argc) reps = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--seed") && i+1 < argc) seed = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--max-itr") && i+1 < argc) maxItr = std::atoi(argv[++i]);
+    else if (!std::strcmp(argv[i], "--max-ms") && i+1 < argc) maxMs = std::atof(argv[++i]);
+    else if (!std::strcmp(argv[i], "--formulation") && i+1 < argc) formulation = argv[++i];
+    else if (!std::strcmp(argv[i], "--null-space")) nullSpace = true;
+    else if (!std::strcmp(argv[i], "--format") && i+1 < argc) format = argv[++i];
+    else if (!std::strcmp(argv[i], "--out") && i+1 < argc) out = argv[++i];
+    else {
+      std::cerr << "usage: admm-bench scaling [--nmin N] [--nmax N] [--step N] "
+                   "[--density p]... [--reps N] [--seed S] [--max-itr N] "
+                   "[--max-ms T] "
+                   "[--formulation vec|svec|herm] [--null-space] "
+                   "[--format csv|json] "
+                   "[--out file]" << std::endl;
+      return 1;
+    }
+  }
+  if (densities.empty()) densities = {0.3};
+  if (format != "csv" && format != "json") {
+    std::cerr << "unknown format '" << format << "'" << std::endl;
+    return 1;
+  }
+
+  Params params;
+  if (maxItr > 0) params.maxItr = maxItr;
+  params.nullSpace = nullSpace;
+  if (formulation == "svec") params.formulation = Formulation::SVec;
+  else if (formulation == "herm") params.formulation = Formulation::Hermitian;
+  else if (!formulation.empty() && formulation != "vec") {
+    std::cerr << "unknown formulation '" << formulation << "'" << std::endl;
+    return 1;
+  }
+
+  // accumulated by the telemetry of both subproblems of a solve
+  Sample s;
+  params.telemetry = [&s](const Telemetry& tel) {
+    if (tel.d == 2) {
+      s.dimX = tel.dimX; s.rowsA = tel.rowsA; s.nnzA = tel.nnzA;
+      s.itr2d = tel.iterations.size();
+    } else {
+      s.itr1d = tel.iterations.size();
+    }
+    s.tParse += tel.tParse;
+    s.tFactorize += tel.tFactorize;
+    s.tProject += tel.tProject;
+    for (const auto& it : tel.iterations) {
+      s.tY += it.tY; s.tEig += it.tEig; s.tUpdate += it.tUpdate;
+      s.tStop += it.tStop;
+    }
+  };
+
+  const bool peakReset = resetPeakRss();
+  if (!peakReset) {
+    std::cerr << "warning: cannot reset peak RSS, peaks are since startup"
+              << std::endl;
+  }
+
+  // Setup grows quickly with n for some formulations (e.g., factorizing A*A'
+  // with Vec), so a density is not swept further once a solve exceeds maxMs.
+  std::vector<Sample> samples;
+  for (const double density : densities) {
+    bool overBudget = false;
+    for (size_t n=nmin; n<=nmax && !overBudget; n+=step) {
+      for (size_t r=0; r<reps; ++r) {
+        const Formation f = randomFormation(n, density, seed + r);
+
+        // a fresh solver, so that nothing is reused across samples
+        Solver solver(params);
+
+        s = Sample();
+        s.n = n;
+        s.density = density;
+        s.rep = r;
+        s.edges = f.adj.sum() / 2;
+
+        trimHeap();
+        if (peakReset) resetPeakRss();
+        s.rssKb = procStatusKb("VmRSS");
+        const auto start = std::chrono::steady_clock::now();
+        solver.solve(f.pts, f.adj);
+        s.tTotal = elapsedMs(start);
+        s.peakKb = procStatusKb("VmHWM");
+
+        samples.push_back(s);
+        overBudget = overBudget || s.tTotal > maxMs;
+        std::cerr << "n = " << n << ", density = " << density << ", rep "
+                  << r << ": " << s.tTotal << " ms" << std::endl;
+      }
+    }
+    if (overBudget) {
+      std::cerr << "density = " << density << ": stopped, over " << maxMs
+                << " ms" << std::endl;
+    }
+  }
+
+  FILE * fp = (out.empty()) ? stdout : std::fopen(out.c_str(), "w");
+  if (fp == nullptr) {
+    std::cerr << "cannot open '" << out << "'" << std::endl;
+    return 1;
+  }
+
+  // n.b., times in ms and memory in kB
+  static const char * fields = "n,density,rep,edges,dim_x,rows_a,nnz_a,"
+      "itr_2d,itr_1d,parse_ms,factorize_ms,y_ms,eig_ms,update_ms,stop_ms,"
+      "project_ms,total_ms,rss_kb,peak_rss_kb";
+  static const char * csv = "%zu,%g,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%.3f,%.3f,"
+      "%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%ld,%ld\n";
+  static const char * json = "  {\"n\": %zu, \"density\": %g, \"rep\": %zu, "
+      "\"edges\": %zu, \"dim_x\": %zu, \"rows_a\": %zu, \"nnz_a\": %zu, "
+      "\"itr_2d\": %zu, \"itr_1d\": %zu, \"parse_ms\": %.3f, "
+      "\"factorize_ms\": %.3f, \"y_ms\": %.3f, \"eig_ms\": %.3f, "
+      "\"update_ms\": %.3f, \"stop_ms\": %.3f, \"project_ms\": %.3f, "
+      "\"total_ms\": %.3f, \"rss_kb\": %ld, \"peak_rss_kb\": %ld}";
+
+  if (format == "csv") std::fprintf(fp, "%s\n", fields);
+  else std::fprintf(fp, "[\n");
+
+  for (size_t k=0; k<samples.size(); ++k) {
+    const auto& x = samples[k];
+    std::fprintf(fp, (format == "csv") ? csv : json, x.n, x.density, x.rep,
+                  x.edges, x.dimX, x.rowsA, x.nnzA, x.itr2d, x.itr1d,
+                  x.tParse, x.tFactorize, x.tY, x.tEig, x.tUpdate, x.tStop,
+                  x.tProject, x.tTotal, x.rssKb, x.peakKb);
+    if (format == "json") {
+      std::fprintf(fp, (k+1 < samples.size()) ? ",\n" : "\n");
+    }
+  }
+
+  if (format == "json") std::fprintf(fp, "]\n");
+  if (fp != stdout) std::fclose(fp);
+
+  return 0;
+}
+
+} // ns bench
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,66 @@
+/**
+ * @file anderson.h
+ * @brief Anderson acceleration of a fixed-point iteration
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Type-II Anderson acceleration of z <-- T(z).
+   *
+   *             The next iterate is the combination of the last few images
+   *             T(z_i) whose fixed-point residuals g_i = T(z_i) - z_i
+   *             combine to the smallest norm (in the least-squares sense).
+   *             The history is dropped whenever the residual grows, which
+   *             falls back to the plain iteration.
+   */
+  class Anderson
+  {
+  public:
+    /**
+     * @param[in]  mem   Number of previous iterates to combine
+     * @param[in]  reg   Tikhonov regularization of the least-squares problem
+     */
+    Anderson(size_t mem, double reg = 1e-10);
+    ~Anderson() = default;
+
+    /**
+     * @brief      Accelerated next iterate
+     *
+     * @param[in]  z     Current iterate
+     * @param[in]  Tz    Image of the current iterate under the iteration
+     *
+     * @return     The next iterate (Tz if there is no usable history)
+     */
+    Eigen::VectorXd step(const Eigen::VectorXd& z, const Eigen::VectorXd& Tz);
+
+    /**
+     * @brief      Forget the history, e.g., when the iteration map changes
+     */
+    void reset();
+
+    size_t restarts() const { return restarts_; }
+
+  private:
+    size_t mem_;
+    double reg_;
+    size_t restarts_ = 0;
+
+    size_t k_ = 0; ///< number of stored differences
+    size_t head_ = 0; ///< column of the oldest difference (circular)
+    Eigen::MatrixXd dG_; ///< differences of residuals g
+    Eigen::MatrixXd dF_; ///< differences of images T(z)
+    Eigen::VectorXd gPrev_, TzPrev_;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,71 @@
+/**
+ * @file batch_solver.h
+ * @brief Gain design of many formations on a pool of worker threads
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "admm/solver.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Designs the gains of a batch of formations (e.g., a whole
+   *             formation group) concurrently.
+   *
+   *             Each worker owns a Solver, i.e., its own factorization
+   *             caches and buffers, which persist across batches. Workers
+   *             pull the next problem from a shared counter and results are
+   *             returned in the order of the problems. Warm starting and the
+   *             gain cache make a solve depend on what the same Solver saw
+   *             before, which depends on scheduling, so they are disabled
+   *             to keep the results deterministic.
+   */
+  class BatchSolver
+  {
+  public:
+    /**
+     * @brief      A gain design problem
+     */
+    struct Problem {
+      Eigen::Matrix<double, 3, Eigen::Dynamic> pts; ///< formation points
+      Eigen::MatrixXd adj; ///< formation graph adjacency matrix
+    };
+
+  public:
+    /**
+     * @param[in]  params      Parameters of each worker's solver. n.b., the
+     *                         telemetry callback is called concurrently.
+     * @param[in]  numWorkers  Number of worker threads, 0 for hardware
+     *                         concurrency
+     */
+    BatchSolver(const Params& params = {}, size_t numWorkers = 0);
+    ~BatchSolver() = default;
+
+    /**
+     * @brief      Designs the gains of each problem
+     *
+     * @param[in]  problems  The formations
+     *
+     * @return     Gain matrices, in the order of problems
+     */
+    std::vector<Eigen::MatrixXd> solve(const std::vector<Problem>& problems);
+
+    size_t numWorkers() const { return solvers_.size(); }
+
+  private:
+    std::vector<std::unique_ptr<Solver>> solvers_; ///< one per worker
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
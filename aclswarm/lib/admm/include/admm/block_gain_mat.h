@@ -0,0 +1,94 @@
+/**
+ * @file block_gain_mat.h
+ * @brief Symmetric block-sparse storage of a formation gain matrix
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Gain matrix (3n x 3n) that only stores its diagonal and
+   *             formation graph edge 3x3 blocks.
+   *
+   *             The gain design constrains A_ij = 0 for non-neighbors, and
+   *             A = -Q \bar{A} Q' is symmetric, so A_ji = A_ij'. Only the
+   *             upper blocks of edges are stored, in a compressed row
+   *             layout with sorted column indices. The stored blocks are
+   *             ordered as A_ii for each i, then A_ij for each edge i < j in
+   *             row-major order, which is also how they are sent in msgs.
+   */
+  class BlockGainMat
+  {
+  public:
+    BlockGainMat() = default;
+    ~BlockGainMat() = default;
+
+    /**
+     * @brief      Zero gains, with the diagonal and edge blocks of a
+     *             formation graph to be filled in (see stored)
+     *
+     * @param[in]  adj   Formation graph adjacency matrix (n x n)
+     */
+    explicit BlockGainMat(const Eigen::MatrixXd& adj);
+
+    /**
+     * @brief      Extracts the diagonal and edge blocks of a dense gain
+     *             matrix. Blocks of non-neighbors are dropped.
+     *
+     * @param[in]  A     Dense gain matrix (3n x 3n)
+     * @param[in]  adj   Formation graph adjacency matrix (n x n)
+     */
+    static BlockGainMat fromDense(const Eigen::MatrixXd& A,
+                                  const Eigen::MatrixXd& adj);
+
+    /**
+     * @brief      Expands into a dense (3n x 3n) gain matrix
+     */
+    Eigen::MatrixXd toDense() const;
+
+    /**
+     * @brief      The 3x3 block A_ij. Zero if i and j are not neighbors.
+     */
+    Eigen::Matrix3d block(size_t i, size_t j) const;
+
+    size_t n() const { return n_; }
+    bool empty() const { return n_ == 0; }
+
+    /**
+     * @brief      Number of stored 3x3 blocks (n + number of edges)
+     */
+    size_t numBlocks() const { return diag_.size() + upper_.size(); }
+
+    /**
+     * @brief      The k-th stored block, in storage order (see above)
+     */
+    const Eigen::Matrix3d& stored(size_t k) const
+    { return (k < n_) ? diag_[k] : upper_[k - n_]; }
+    Eigen::Matrix3d& stored(size_t k)
+    { return (k < n_) ? diag_[k] : upper_[k - n_]; }
+
+  private:
+    size_t n_ = 0; ///< number of agents
+    std::vector<Eigen::Matrix3d> diag_; ///< A_ii
+    std::vector<size_t> rowPtr_; ///< row i edges in [rowPtr_[i], rowPtr_[i+1])
+    std::vector<size_t> cols_; ///< column index j > i of each edge block
+    std::vector<Eigen::Matrix3d> upper_; ///< A_ij, i < j
+
+    /**
+     * @brief      Index into upper_ of block (i,j), i < j. -1 if not an edge.
+     */
+    int find(size_t i, size_t j) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
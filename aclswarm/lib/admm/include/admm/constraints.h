@@ -0,0 +1,124 @@
+/**
+ * @file constraints.h
+ * @brief Linear constraint operator of the ADMM gain design SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include "admm/null_space.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      The linear map \mathbf{A} : vec(X) -> R^p of the gain design
+   *             SDP, its adjoint and the solution of the normal equations.
+   *
+   *             Either wraps an explicit sparse matrix (and the Cholesky
+   *             factorization of A*A'), or applies the graph constraints
+   *             matrix-free. Each zero-gain constraint of a non-neighbor
+   *             pair is the rank-1 functional q_j' \bar{A} q_i = 0, where
+   *             q_i is a row of Q. Materializing it would take (dm)^2
+   *             coefficients; matrix-free it is applied through products
+   *             with Q and the normal equations are solved with PCG.
+   *
+   *             Or, parametrizing the feasible set (see NullSpace), A is the
+   *             orthogonal projector onto the complement of the subspace
+   *             parallel to it. Then A*A' = A, whose normal equations are
+   *             trivial for the right-hand sides of ADMM (in its range).
+   */
+  class Constraints
+  {
+  public:
+    using SpMat = Eigen::SparseMatrix<double>;
+    using Cholesky = Eigen::SimplicialCholesky<SpMat>;
+
+    /// \brief (row of Q selecting i, row of Q selecting j) of [\bar{A}]_ij
+    using GraphRow = std::pair<size_t, size_t>;
+
+  public:
+    /**
+     * @brief      Explicit constraints, A and the factorization of A*A'
+     */
+    Constraints(const SpMat& A, const Cholesky& AAs);
+
+    /**
+     * @brief      Matrix-free constraints
+     *
+     * @param[in]  As      Explicit (sparse) rows, i.e., all except graph
+     * @param[in]  graph   Graph constraint rows, appended after As rows
+     * @param[in]  Q       Orth. compl. of gain matrix kernel (dn x dm)
+     * @param[in]  cgTol   Relative residual tolerance of the PCG solve
+     * @param[in]  cgMaxItr  Maximum number of PCG iterations
+     */
+    Constraints(const SpMat& As, const std::vector<GraphRow>& graph,
+                const Eigen::MatrixXd& Q, double cgTol, size_t cgMaxItr);
+
+    /**
+     * @brief      Constraints of a parametrized feasible set, b is then
+     *             ns.particular()
+     */
+    explicit Constraints(const NullSpace& ns);
+
+    ~Constraints() = default;
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+
+    /**
+     * @brief      Number of stored coefficients (nonzeros of A, or of the
+     *             explicit rows plus Q when matrix-free)
+     */
+    size_t storage() const;
+
+    /// \brief In place, into vectors of the right size. With explicit
+    /// constraints these do not allocate. The scratch is only used by the
+    /// null-space projection.
+    void apply(const Eigen::VectorXd& x, Eigen::VectorXd& Ax,
+               NullSpace::Scratch& scratch) const; ///< A*x
+    void applyAdjoint(const Eigen::VectorXd& y, Eigen::VectorXd& Aty,
+                      NullSpace::Scratch& scratch) const; ///< A' * y
+    void solveNormal(const Eigen::VectorXd& e,
+                      Eigen::VectorXd& y) const; ///< (A*A') \ e
+
+  private:
+    enum class Mode { Explicit, MatrixFree, NullSpace };
+    Mode mode_;
+    size_t rows_, cols_;
+
+    /// \brief Explicit constraints
+    const SpMat* A_ = nullptr;
+    SpMat At_; ///< dual operator
+    const Cholesky* AAs_ = nullptr;
+
+    /// \brief Matrix-free constraints
+    SpMat As_, Ast_; ///< explicit rows and their transpose
+    std::vector<GraphRow> graph_;
+    Eigen::MatrixXd Q_;
+    size_t N_; ///< dimension of X (2dm)
+    size_t dm_; ///< dimension of \bar{A}, i.e., offset of X_22 in X
+    Eigen::VectorXd precond_; ///< inverse of diag(A*A')
+    double cgTol_;
+    size_t cgMaxItr_;
+
+    /// \brief Parametrized feasible set
+    const NullSpace* ns_ = nullptr;
+
+    void applyDense(const Eigen::VectorXd& x, Eigen::VectorXd& Ax) const;
+    void applyAdjointDense(const Eigen::VectorXd& y,
+                            Eigen::VectorXd& Aty) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,108 @@
+/**
+ * @file gain_cache.h
+ * @brief LRU cache of designed gains, keyed by formation shape
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "admm/block_gain_mat.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Least-recently-used cache of gain matrices, which only
+   *             keep their diagonal and edge blocks (see BlockGainMat).
+   *
+   *             The gain matrix only depends on the formation through the
+   *             kernels of the 2D and 1D subproblems, i.e., span{qxy, Jqxy,
+   *             1} and span{qz, 1}, or span{1} if flat planar. These are
+   *             invariant to translation, rotation about z and scaling, so
+   *             the gains of a formation are valid as-is for any such
+   *             transformation of it and nothing needs to be transformed
+   *             back. The key is the graph and the formation points in a
+   *             canonical pose:
+   *
+   *               - xy: centered, rotated so that the first agent away
+   *                     from the centroid lies on +x, unit RMS radius
+   *               - z:  centered and unit std. dev., or zero if the
+   *                     formation is flat planar, since altitude then has
+   *                     no effect on the gains
+   *
+   *             Canonical coordinates are quantized before hashing, so
+   *             formations equal up to the quantum share an entry.
+   */
+  class GainCache
+  {
+  public:
+    /**
+     * @param[in]  capacity  Maximum number of cached gain matrices
+     * @param[in]  quantum   Quantization of canonical coordinates
+     * @param[in]  thrPlanar If std(qz) less, formation is flat planar
+     */
+    GainCache(size_t capacity, double quantum, double thrPlanar);
+    ~GainCache() = default;
+
+    /**
+     * @brief      Looks up the gains of an equivalent formation. A hit
+     *             becomes the most recently used entry.
+     *
+     * @param[in]  pts    Formation points (3 x n)
+     * @param[in]  adj    Formation graph adjacency matrix (n x n)
+     * @param      gains  Cached gains, if found
+     *
+     * @return     True if found
+     */
+    bool find(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+              const Eigen::MatrixXd& adj, BlockGainMat& gains);
+
+    /**
+     * @brief      Stores the gains of a formation, evicting the least
+     *             recently used entry if at capacity.
+     */
+    void insert(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, const BlockGainMat& gains);
+
+    void clear();
+
+    size_t size() const { return entries_.size(); }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+  private:
+    using Key = std::vector<int64_t>;
+
+    struct KeyHash {
+      size_t operator()(const Key& key) const;
+    };
+
+    using Entry = std::pair<Key, BlockGainMat>;
+
+    size_t capacity_;
+    double quantum_;
+    double thrPlanar_;
+
+    size_t hits_ = 0, misses_ = 0;
+
+    /// \brief Entries ordered from most to least recently used
+    std::list<Entry> entries_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+
+    Key makeKey(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,76 @@
+/**
+ * @file gain_design.h
+ * @brief Common interface of formation gain design backends
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "admm/block_gain_mat.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      A formation gain design backend, e.g., the ADMM Solver of
+   *             this library or the MATLAB-generated solver (aclswarm::ADMM)
+   */
+  class GainDesign
+  {
+  public:
+    /**
+     * @brief      Quality of the gains returned by a (time-budgeted) solve,
+     *             i.e., the worst of the two subproblems. Backends that cannot
+     *             report a measure leave it NaN.
+     */
+    struct Quality {
+      bool converged = true; ///< false if a deadline (or cancel) cut ADMM short
+      bool cacheHit = false; ///< from the gain cache (nothing else is set)
+      double trErr = 0; ///< |Tr[\bar{A}] - dm| / dm
+      double primalRes = 0; ///< ||A(X) - b|| / (1 + ||b||), before final proj.
+      double dualRes = 0; ///< ||C - A'y - S|| / (1 + ||C||)
+      double eigMargin = 0; ///< min eig of \bar{A}; > 0 if gains stabilize
+    };
+
+  public:
+    virtual ~GainDesign() = default;
+
+    /**
+     * @brief      Short name of the backend, e.g., for logging
+     */
+    virtual const char * name() const = 0;
+
+    /**
+     * @brief      Designs the gains within a time budget
+     *
+     * @param[in]  pts       Desired formation points (3 x n)
+     * @param[in]  adj       Formation graph adjacency matrix
+     * @param[in]  deadline  Time budget (ms), or 0 for none
+     * @param[out] quality   Quality of the returned gains
+     *
+     * @return     The dense (3n x 3n) gain matrix
+     */
+    virtual Eigen::MatrixXd solve(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) = 0;
+
+    /**
+     * @brief      Designs the gains, keeping only the diagonal and edge
+     *             blocks (see BlockGainMat)
+     */
+    virtual BlockGainMat solveBlocks(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline, Quality& quality)
+    {
+      return BlockGainMat::fromDense(solve(pts, adj, deadline, quality), adj);
+    }
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
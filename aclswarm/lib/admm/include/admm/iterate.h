@@ -0,0 +1,69 @@
+/**
+ * @file iterate.h
+ * @brief Hybrid sparse/dense storage of an ADMM iterate
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      An ADMM iterate (X or S) between solves, i.e., as seeded,
+   *             warm started and returned. The initial X = [I I; I I] and
+   *             S = 0 are very sparse, but after the first iteration both
+   *             are effectively dense. Then sparse storage only costs
+   *             conversions and slow products (e.g., recovering the gains),
+   *             so the iterate is kept dense column-major once its fill
+   *             crosses a threshold.
+   */
+  class Iterate
+  {
+  public:
+    using SpMat = Eigen::SparseMatrix<double>;
+
+  public:
+    Iterate() = default;
+    explicit Iterate(const SpMat& X) : sparse_(X) {}
+    ~Iterate() = default;
+
+    size_t rows() const { return (dense_) ? D_.rows() : sparse_.rows(); }
+    size_t cols() const { return (dense_) ? D_.cols() : sparse_.cols(); }
+    bool isDense() const { return dense_; }
+
+    /**
+     * @brief      Stores X, dense if more than maxFill of its entries are
+     *             nonzero and sparse (dropping exact zeros) otherwise
+     */
+    void assign(const Eigen::MatrixXd& X, double maxFill);
+
+    /**
+     * @brief      Copies into a dense matrix (e.g., an ADMM buffer)
+     */
+    void copyTo(Eigen::MatrixXd& X) const;
+
+    /**
+     * @brief      Dense copy of the trailing k x k block, e.g., \bar{A}
+     */
+    Eigen::MatrixXd bottomRightCorner(size_t k) const;
+
+    /**
+     * @brief      T' X T, e.g., a change of basis of a warm start
+     */
+    Eigen::MatrixXd congruence(const Eigen::MatrixXd& T) const;
+
+  private:
+    bool dense_ = false;
+    SpMat sparse_;
+    Eigen::MatrixXd D_;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,42 @@
+/**
+ * @file lanczos.h
+ * @brief Partial symmetric eigendecomposition via restarted Lanczos
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Computes the eigenpairs of a symmetric matrix whose
+   *             eigenvalues are above a threshold.
+   *
+   *             Runs Lanczos with full reorthogonalization. Converged Ritz
+   *             pairs above the threshold are deflated and Lanczos is
+   *             restarted, which also recovers repeated eigenvalues (a
+   *             single Krylov sequence only sees one vector of each
+   *             eigenspace). It is done once the dominant Ritz value of a
+   *             run converges below the threshold.
+   *
+   * @param[in]  W         The symmetric matrix
+   * @param[in]  thresh    Only eigenvalues larger than thresh are wanted
+   * @param[in]  maxModes  Give up if there are more eigenvalues than this
+   * @param[in]  tol       Ritz residual tolerance, relative to ||W||
+   * @param      evals     Eigenvalues larger than thresh (unordered)
+   * @param      evecs     Corresponding eigenvectors
+   *
+   * @return     False if there were too many modes or the work exceeded
+   *             that of a dense eigendecomposition (caller should fall back)
+   */
+  bool lanczosAbove(const Eigen::MatrixXd& W, double thresh, size_t maxModes,
+                    double tol, Eigen::VectorXd& evals, Eigen::MatrixXd& evecs);
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,129 @@
+/**
+ * @file low_rank.h
+ * @brief Burer-Monteiro solver of the dual of the gain design SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <deque>
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+#include "admm/null_space.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Low-rank solver of the gain design SDP without eigensolves.
+   *
+   *             With X_11 = tI and X_12 = I, X >= 0 iff \bar{A} >= I/t, so
+   *             the SDP maximizes the smallest eigenvalue of \bar{A} over its
+   *             feasible affine subspace A_0 + S (see NullSpace). Its dual,
+   *
+   *                min <A_0, Z>  s.t.  Z >= 0, Tr[Z] = 1, P_S(Z) = 0,
+   *
+   *             has a solution whose rank is the multiplicity of that
+   *             eigenvalue, i.e., small. The factor V (dm x r) of Z = VV' is
+   *             optimized on the sphere |V| = 1 by Riemannian gradient
+   *             descent on the augmented Lagrangian
+   *
+   *                <\bar{A}, VV'> + sigma/2 |P_S(VV')|^2,
+   *
+   *             and \bar{A} = A_0 - Y, with Y in S, is its multiplier: it is
+   *             feasible by construction. In the gain coordinates of
+   *             NullSpace, P_S(VV') only needs the entries of (QV)(QV)' on
+   *             the graph, so an iteration costs O(dn * dm * r).
+   */
+  class LowRank
+  {
+  public:
+    /**
+     * @param[in]  ns     Feasible gains of the subproblem
+     * @param[in]  Q      Orth. compl. of gain matrix kernel (dn x dm)
+     * @param[in]  rank   Number of columns r of V
+     * @param[in]  sigma  Augmented Lagrangian penalty
+     */
+    LowRank(const NullSpace& ns, const Eigen::MatrixXd& Q, size_t rank,
+            double sigma);
+    ~LowRank() = default;
+
+    /**
+     * @brief      One Riemannian gradient step on V (Barzilai-Borwein step
+     *             length, safeguarded by a nonmonotone backtracking)
+     *
+     * @return     Norm of the Riemannian gradient before the step
+     */
+    double step();
+
+    /**
+     * @brief      Multiplier update, \bar{A} <- \bar{A} + sigma P_S(VV')
+     */
+    void updateMultiplier();
+
+    /**
+     * @brief      Moves Z towards U U' (orthonormal U, dm x k), i.e., appends
+     *             the columns of U to V. Escapes a saddle point where eigen-
+     *             vectors of \bar{A} below the objective are missing from V.
+     *
+     * @param[in]  U      Directions, e.g., eigenvectors of \bar{A}
+     * @param[in]  theta  Weight of U U' in the new Z, in (0, 1)
+     */
+    void escape(const Eigen::MatrixXd& U, double theta);
+
+    size_t rank() const { return V_.cols(); }
+    double infeasibility() const { return c_.norm(); } ///< |P_S(VV')|
+    double objective() const { return w_.dot(e_); } ///< <\bar{A}, VV'>
+
+    /**
+     * @brief      The current multiplier \bar{A} (dm x dm)
+     */
+    Eigen::MatrixXd abar() const;
+
+  private:
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    const NullSpace& ns_;
+    const Eigen::MatrixXd& Q_;
+    double sigma_;
+
+    Eigen::VectorXd w_; ///< gain coordinates of \bar{A}
+    Eigen::MatrixXd V_; ///< factor of Z (dm x r)
+    Eigen::VectorXd e_; ///< E'vec(QVV'Q'), i.e., before projection
+    Eigen::VectorXd c_; ///< gain coordinates of P_S(VV')
+    double f_; ///< augmented Lagrangian at V
+
+    /// \brief Riemannian gradient and the previous step (Barzilai-Borwein)
+    Eigen::MatrixXd rgrad_, Vprev_, rgradPrev_;
+    bool bb_ = false; ///< if the previous step is valid
+    double eta_; ///< step length
+
+    /// \brief Last values of the augmented Lagrangian (nonmonotone search)
+    static constexpr size_t memory = 10;
+    std::deque<double> fhist_;
+
+    /// \brief Buffers, e.g., of the trial point of a step
+    Eigen::MatrixXd Vnew_;
+    Eigen::VectorXd eTry_, cTry_;
+    mutable Eigen::MatrixXd Tt_, GTt_;
+    mutable NullSpace::Scratch nsScratch_;
+
+    /**
+     * @brief      Evaluates the augmented Lagrangian at V, i.e., e, c and f
+     */
+    double evaluate(const Eigen::MatrixXd& V, Eigen::VectorXd& e,
+                    Eigen::VectorXd& c) const;
+
+    /**
+     * @brief      Riemannian gradient at V_ (with e_ and c_ up to date)
+     */
+    void gradient(Eigen::MatrixXd& rgrad) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
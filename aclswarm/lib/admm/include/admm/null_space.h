@@ -0,0 +1,112 @@
+/**
+ * @file null_space.h
+ * @brief Parametrization of the feasible affine subspace of the gain SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      The affine subspace of X = [X_11 X_12; X_21 \bar{A}] cut out
+   *             by the equality constraints of the gain design SDP, i.e.,
+   *             X_11 = tI, X_12 = I, \bar{A} structured with zero gains for
+   *             non-neighbors and Tr[\bar{A}] = dm.
+   *
+   *             Instead of rows of A, \bar{A} is parametrized by the gain
+   *             matrix G = Q \bar{A} Q', an isometry since Q'Q = I. The graph
+   *             zeros and the 2D structure [a b; -b a] of G are then simply
+   *             coordinates that are not there: G = E g, where the columns of
+   *             E form an orthonormal basis of gains supported on the graph.
+   *             Only the kernel, G = QQ' G QQ', couples the coordinates, with
+   *             O(dn) rows B g = vec(G K) (K spans the kernel) instead of
+   *             O(n^2) graph rows.
+   *
+   *             Since Q J = J Q for the 2D rotation J, \bar{A} is structured
+   *             iff G is.
+   */
+  class NullSpace
+  {
+  public:
+    using SpMat = Eigen::SparseMatrix<double>;
+
+    /**
+     * @brief      Buffers of the projections. n.b., owned by the caller, since
+     *             solvers may share the null space (see Solver::setup).
+     */
+    struct Scratch {
+      Eigen::MatrixXd M, T; ///< G and Q \bar{A}, or G Q
+      Eigen::VectorXd g, r; ///< gain coordinates, kernel residual
+    };
+
+  public:
+    /**
+     * @param[in]  d      Ambient dimension (1 or 2)
+     * @param[in]  adj    Formation graph adjacency matrix (n x n)
+     * @param[in]  Q      Orth. compl. of gain matrix kernel (dn x dm)
+     * @param[in]  shift  Factorize B*B' + shift*I (redundant kernel rows)
+     */
+    NullSpace(size_t d, const Eigen::MatrixXd& adj, const Eigen::MatrixXd& Q,
+              double shift);
+    ~NullSpace() = default;
+
+    /**
+     * @brief      Length of the reduced decision vector (t, g). The kernel
+     *             rows remove O(dn) of its degrees of freedom, the trace one.
+     */
+    size_t coordinates() const { return 1 + E_.cols(); }
+
+    size_t ambient() const { return N_*N_; } ///< length of vec(X)
+
+    /**
+     * @brief      Number of stored coefficients (E, B and Q)
+     */
+    size_t storage() const;
+
+    /**
+     * @brief      Orthogonal projection of vec(X) onto the subspace parallel
+     *             to the feasible one, in place into a vector of the same size
+     */
+    void project(const Eigen::VectorXd& x, Eigen::VectorXd& Px,
+                 Scratch& scratch) const;
+
+    /**
+     * @brief      The feasible X of least norm, vectorized
+     */
+    Eigen::VectorXd particular() const;
+
+    /// \brief The same in the coordinates g of the gains G = E g, where the
+    /// columns of E (basis()) are orthonormal patterns of vec(G)
+    const SpMat& basis() const { return E_; }
+    void projectGains(Eigen::VectorXd& g,
+                      Scratch& scratch) const; ///< in place, uses scratch.r
+    Eigen::VectorXd particularGains() const;
+
+  private:
+    size_t N_; ///< dimension of X (2dm)
+    size_t dm_; ///< dimension of \bar{A}, i.e., offset of X_22 in X
+
+    Eigen::MatrixXd Q_;
+    SpMat E_, Et_; ///< orthonormal basis of graph supported (structured) gains
+    SpMat B_, Bt_; ///< g -> vec(G K), kernel of the gain matrix
+    Eigen::SimplicialCholesky<SpMat> BBs_; ///< factorization of B*B'
+    Eigen::VectorXd gtr_; ///< unit g of the trace functional on the subspace
+    double trNorm_; ///< norm of the trace functional
+
+    /**
+     * @brief      Projects coordinates g onto the kernel constraint, B g = 0
+     */
+    void projectKernel(Eigen::VectorXd& g, Eigen::VectorXd& r) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
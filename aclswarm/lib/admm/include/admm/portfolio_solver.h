@@ -0,0 +1,143 @@
+/**
+ * @file portfolio_solver.h
+ * @brief Gain design racing several solver configurations on worker threads
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "admm/gain_cache.h"
+#include "admm/gain_design.h"
+#include "admm/solver.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Designs the gains of a formation with several configurations
+   *             of the ADMM Solver at once (e.g., different mu and
+   *             relaxation), since the best one differs per formation.
+   *
+   *             The subproblems of a formation are set up (parsed,
+   *             equilibrated and factorized) once, with the parameters of
+   *             the first configuration, so the configurations must only
+   *             differ in those of the iterations. Each configuration
+   *             (member) then owns a Solver, i.e., its own warm starts and
+   *             buffers, and iterates on its own thread from the shared
+   *             subproblems. The first member whose gains are acceptable
+   *             wins and the others are cancelled at their next ADMM
+   *             iteration. If none are, the gains with the largest eigenvalue
+   *             margin are returned. The gain cache is shared by the members.
+   */
+  class PortfolioSolver : public GainDesign
+  {
+  public:
+    /**
+     * @brief      Quality that a member's gains must have to win
+     */
+    struct Acceptance {
+      bool converged = true; ///< not cut short by the deadline
+      double maxTrErr = 1e-6; ///< |Tr[\bar{A}] - dm| / dm
+      double minEigMargin = 0; ///< min eig of \bar{A}, i.e., stabilizing
+
+      /// \brief Residuals of the last iteration, to tell a member that ran out
+      /// of iterations from converged ones. n.b., the defaults are those of
+      /// Params::epsPrimal and epsDual (see Params::residualStop).
+      double maxPrimalRes = 1e-6;
+      double maxDualRes = 1e-6;
+    };
+
+  public:
+    /**
+     * @param[in]  configurations  Parameters of each member. n.b., the
+     *                             telemetry callbacks are called
+     *                             concurrently.
+     * @param[in]  acceptance      Quality criteria of the winning gains
+     */
+    PortfolioSolver(const std::vector<Params>& configurations,
+                    const Acceptance& acceptance);
+    explicit PortfolioSolver(const std::vector<Params>& configurations);
+    ~PortfolioSolver() = default;
+
+    /**
+     * @brief      A default portfolio around params: its mu and ten times
+     *             it, each without and with over-relaxation. Each member runs
+     *             to the residual tolerances (see Params::residualStop), so
+     *             params.maxItr should leave room for that.
+     */
+    static std::vector<Params> configurations(const Params& params = {});
+
+    const char * name() const override { return "portfolio"; }
+
+    /**
+     * @brief      Designs the gains within a time budget (see Solver::solve)
+     */
+    Eigen::MatrixXd solve(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) override;
+
+    /**
+     * @brief      Designs the gains within a time budget, keeping only the
+     *             diagonal and edge blocks of the winner's (see BlockGainMat)
+     */
+    BlockGainMat solveBlocks(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) override;
+
+    size_t size() const { return solvers_.size(); }
+
+    /**
+     * @brief      Member whose gains the last solve returned
+     */
+    size_t winner() const { return winner_; }
+
+    const Solver& member(size_t i) const { return *solvers_[i]; }
+
+  private:
+    std::vector<std::unique_ptr<Solver>> solvers_; ///< one per member
+    Acceptance acceptance_;
+    size_t winner_ = 0;
+
+    /// \brief Set once a member wins, polled by the others
+    std::atomic<bool> cancel_;
+
+    /// \brief Gains of recently designed formations
+    size_t cacheSize_;
+    GainCache cache_;
+
+    /// \brief Solves the subproblems of a formation with member i
+    using MemberSolve = std::function<void(size_t i,
+                          const Solver::Problem& problem, double deadline,
+                          Quality& quality)>;
+
+    /**
+     * @brief      Sets up the subproblems of a formation once and races the
+     *             members on them. Sets the winner.
+     *
+     * @param[in]  pts       Desired formation points (3 x n)
+     * @param[in]  adj       Formation graph adjacency matrix
+     * @param[in]  deadline  Time budget (ms), or 0 for none
+     * @param[out] quality   Quality of the winner's gains
+     * @param[in]  solve     Solves with a member, keeping its gains
+     */
+    void race(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+              const Eigen::MatrixXd& adj, double deadline, Quality& quality,
+              const MemberSolve& solve);
+
+    bool accepted(const Quality& quality) const;
+  };
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
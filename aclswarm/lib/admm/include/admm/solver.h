@@ -5,13 +5,39 @@
  * @date 25 July 2020
  */
 
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+
 #include <Eigen/Core>
+#include <Eigen/Eigenvalues>
 #include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include "admm/block_gain_mat.h"
+#include "admm/constraints.h"
+#include "admm/gain_design.h"
+#include "admm/gain_cache.h"
+#include "admm/iterate.h"
+#include "admm/telemetry.h"
 
 namespace acl {
 namespace aclswarm {
 namespace admm {
 
+  /**
+   * @brief      Vectorization of the symmetric decision variable X
+   */
+  enum class Formulation {
+    Vec, ///< column-major vec(X), with explicit [X]_ij == [X]_ji rows in A
+    SVec, ///< upper triangle with sqrt(2)-scaled off-diagonals (isometric)
+    Hermitian, ///< 2D: X as an m' x m' complex Hermitian matrix (see hermsel)
+               ///< with the [a b; -b a] structure implied; 1D: SVec
+  };
+
   /**
    * @brief      User parameters for ADMM solver
    */
@@ -28,11 +54,226 @@ namespace admm {
     double thresh = 1e-4; ///< threshold for change in decision variable, X
     double threshTr = 0.10; ///< if Tr[\bar{A}] within this percent of desired, stop.
     size_t maxItr = 10; ///< maximum number of ADMM iterations
+
+    // \brief Stop once the relative primal and dual residuals are below
+    // these tolerances, instead of on the diffX and trace heuristics.
+    bool residualStop = false;
+    double epsPrimal = 1e-6; ///< ||A(X) - b|| / (1 + ||b||)
+    double epsDual = 1e-6; ///< ||C - A'y - S|| / (1 + ||C||)
+
+    // \brief Residual balancing: mu is scaled by muFactor whenever one
+    // residual is muBalance times the other (a larger mu favors primal).
+    bool adaptiveMu = false;
+    double muBalance = 10; ///< allowed ratio between residuals
+    double muFactor = 2; ///< multiplicative update of mu
+    double muMin = 1e-4; ///< lower bound on adapted mu
+    double muMax = 1e4; ///< upper bound on adapted mu
+
+    // \brief Over-relaxation of A'y in the S and X updates, in (0, 2).
+    double alpha = 1.0; ///< 1 is plain ADMM
+
+    // \brief Anderson acceleration of the (X, S) fixed-point iteration
+    size_t andersonMem = 0; ///< number of iterates combined, 0 to disable
+
+    // \brief Build constraints with the ambient dimension (1 or 2) fixed at
+    // compile time. Otherwise it is a runtime value (for comparison). n.b.,
+    // only the parse is specialized: the ADMM iterations are the same.
+    bool specializeDim = true;
+
+    // \brief Called with the telemetry of each subproblem solve, if set.
+    // Timing is only recorded then. n.b., with parallel, it is called from
+    // two threads at once.
+    std::function<void(const Telemetry&)> telemetry;
+
+    // \brief Symmetric vectorization drops the symmetry rows from A and
+    // roughly halves the number of columns. The Hermitian formulation also
+    // drops the 2D structure rows and projects onto the PSD cone with a
+    // complex eigensolver of half the dimension. Matrix-free always uses Vec.
+    Formulation formulation = Formulation::Vec;
+
+    // \brief Skip ADMM for complete graphs: without graph constraints the
+    // optimum is \bar{A} = I, i.e., the gain matrix is -Q*Q'.
+    bool closedForm = true;
+
+    // \brief Warm starting
+    bool warmStart = false; ///< init ADMM from last solve of the same size
+
+    // \brief Ruiz equilibration of the explicit constraints of the Hermitian
+    // formulation. Rows of A are scaled, and X = D \tilde{X} D for a
+    // diagonal D (a congruence, so the PSD cone is kept). Stopping criteria,
+    // stats and the returned X are in the original scaling. Only applies to
+    // Formulation::Hermitian: with Vec and SVec, D = I and the row scaling
+    // cannot change the iterates. Ignored when matrix-free or null-space.
+    bool equilibrate = false;
+    size_t equilibrateItr = 10; ///< number of Ruiz passes
+
+    // \brief Keep an iterate (X, S) dense between solves, i.e., as returned,
+    // warm started and used to recover the gains, once more than this
+    // fraction of its entries is nonzero (see Iterate).
+    double denseFill = 0.1;
+
+    // \brief Reuse symbolic analysis of A*A' if sparsity pattern unchanged
+    bool cacheFactorization = true;
+    double shiftAAs = 1e-12; ///< factorize A*A' + shift*I (redundant rows)
+
+    // \brief Apply graph constraints through Q instead of storing them in A.
+    // Needs O(n^2) instead of O(n^4) memory, but solves A*A' with PCG.
+    bool matrixFree = false;
+    double cgTol = 1e-12; ///< relative residual tolerance of PCG
+    size_t cgMaxItr = 1000; ///< maximum number of PCG iterations
+
+    // \brief Parametrize the feasible affine subspace of X (see NullSpace)
+    // instead of building the equality rows of A. ADMM then only couples it
+    // with the PSD cone, and its y update is a projection with O(dn) kernel
+    // rows instead of a solve with O(n^2) graph rows. Always uses Vec and
+    // takes precedence over matrix-free.
+    bool nullSpace = false;
+
+    // \brief Solve the SDP by a low-rank (Burer-Monteiro) factorization of
+    // its dual instead of ADMM (see LowRank). \bar{A} is feasible at every
+    // step and is only eigendecomposed on convergence, to escape saddle
+    // points. Stops once the Riemannian gradient and the infeasibility of the
+    // dual factor are below lowRankTol. The ADMM options (mu, stopping
+    // criteria, warm start...) do not apply.
+    bool lowRank = false;
+    size_t lowRankDim = 0; ///< rank of the factor, 0 for the Pataki bound
+    double lowRankSigma = 100; ///< augmented Lagrangian penalty
+    double lowRankTol = 1e-6; ///< stopping tolerance
+    size_t lowRankMaxItr = 10000; ///< maximum number of gradient steps
+
+    // \brief Compute only the positive modes of the PSD projection with
+    // Lanczos. Falls back to a dense eigensolver if there are too many.
+    bool eigPartial = false;
+    double eigPartialMaxFrac = 0.25; ///< max fraction of positive modes
+    double eigPartialTol = 1e-10; ///< Ritz residual tol (relative to |W|)
+
+    // \brief Solve the 2D and 1D subproblems concurrently and assemble the
+    // 3D gain matrix with a pool of threads.
+    bool parallel = false;
+    size_t numThreads = 0; ///< assembly workers, 0 for hardware concurrency
+
+    // \brief Reuse the gains of formations equal up to translation, rotation
+    // about z and scale (see GainCache). Disabled if cacheSize is 0.
+    size_t cacheSize = 0; ///< max number of cached gain matrices
+    double cacheQuantum = 1e-6; ///< quantization of canonical formation pts
   };
 
-  class Solver
+  class Solver : public GainDesign
   {
   public:
+    using SpMat = Eigen::SparseMatrix<double>;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief      ADMM state of a previous solve, used to seed the next one
+     */
+    struct WarmStart {
+      Eigen::MatrixXd Q; ///< orth. compl. of kernel that X is expressed in
+      Iterate X; ///< primal decision variable [X_11 X_12; X_21 \bar{A}]
+      Iterate S; ///< dual slack variable
+    };
+
+    /**
+     * @brief      Convergence of the last ADMM solve of a subproblem
+     */
+    struct Stats {
+      size_t iterations = 0; ///< number of ADMM iterations
+      double primalRes = 0; ///< ||A(X) - b|| / (1 + ||b||), before final proj.
+      double dualRes = 0; ///< ||C - A'y - S|| / (1 + ||C||)
+      double mu = 0; ///< penalty at the last iteration
+      size_t andersonRestarts = 0; ///< rejected Anderson extrapolations
+      bool deadline = false; ///< stopped by the deadline, not convergence
+      bool cancelled = false; ///< stopped by the cancel flag
+      double trErr = 0; ///< |Tr[\bar{A}] - dm| / dm, after final projection
+      double eigMargin = 0; ///< min eigenvalue of \bar{A}, after final proj.
+    };
+
+    /**
+     * @brief      Factorization of A*A', whose symbolic analysis only depends
+     *             on the problem size and the formation graph.
+     */
+    struct FactorCache {
+      size_t d = 0; ///< ambient dimension of cached subproblem
+      size_t n = 0; ///< number of vehicles of cached subproblem
+      Eigen::MatrixXd adj; ///< formation graph of cached subproblem
+      SpMat AAs; ///< A*A' whose sparsity pattern was analyzed
+      Eigen::SimplicialCholesky<SpMat> chol; ///< factorization of AAs
+    };
+
+    /**
+     * @brief      Ruiz equilibration of a subproblem, i.e., the constraints
+     *             R A(D \tilde{X} D) = R b with diagonal R and D
+     */
+    struct Scaling {
+      Eigen::VectorXd dX, dXinv; ///< diagonal of D and of its inverse
+      Eigen::VectorXd drinv; ///< inverse of the diagonal of R
+    };
+
+    /**
+     * @brief      Buffers of the ADMM iterations of a subproblem. They are
+     *             (re)sized when the problem dimensions change, so that the
+     *             iterations themselves do not allocate.
+     */
+    struct Workspace {
+      size_t N = 0; ///< dimension of X (2dm)
+      Eigen::MatrixXd X, Xold, S, Sold; ///< iterates, dense
+      Eigen::MatrixXd W, H, D; ///< C - H - mu*X, sym(A'y) and temporaries
+      Eigen::VectorXd x, Ax, y, Aty, b; ///< vectorized, constraint space
+      Eigen::VectorXd z, Tz; ///< (X, S) stacked for Anderson acceleration
+      NullSpace::Scratch ns; ///< see Params::nullSpace
+
+      /// \brief PSD projection
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+      Eigen::MatrixXd V; ///< scaled positive modes
+      Eigen::MatrixXcd Z, Zp, Vc; ///< Hermitian formulation
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> esc;
+      size_t Nes = 0, Mesc = 0; ///< sizes the eigensolvers are set up for
+
+      /**
+       * @param[in]  N     Dimension of X
+       * @param[in]  nx    Number of columns of A (length of vectorized X)
+       * @param[in]  ny    Number of rows of A
+       * @param[in]  f     Formulation (buffers of the eigensolver)
+       * @param[in]  anderson  If Anderson acceleration is used
+       */
+      void resize(size_t N, size_t nx, size_t ny, Formulation f,
+                  bool anderson);
+    };
+
+    /**
+     * @brief      A gain design subproblem, parsed, equilibrated and with its
+     *             constraint operator factorized, i.e., all that a solve does
+     *             before iterating. It is only read by the solves, so that
+     *             several solvers (e.g., threads) can share it.
+     */
+    struct Subproblem {
+      size_t d = 0; ///< ambient dimension
+      size_t m = 0; ///< dimension of the orth. compl. of the kernel
+      size_t n = 0; ///< number of vehicles
+      Eigen::MatrixXd adj; ///< formation graph
+      Eigen::MatrixXd Q; ///< orth. compl. of the kernel of the gains
+      Formulation f = Formulation::Vec;
+      bool closedForm = false; ///< complete graph (see Params::closedForm)
+      SpMat C, A, b, X0; ///< SDP data and initial X
+      std::vector<Constraints::GraphRow> graph; ///< see Params::matrixFree
+      Scaling scaling; ///< see Params::equilibrate
+      bool scaled = false; ///< if C, A and b are equilibrated
+      std::unique_ptr<NullSpace> ns; ///< see Params::nullSpace, lowRank
+      std::unique_ptr<Constraints> op; ///< refers to A, ns or a FactorCache
+      Telemetry tel; ///< timing of the setup
+    };
+
+    /**
+     * @brief      Both gain design subproblems of a formation (see setup).
+     *             Not copyable: the constraint operators refer to its data.
+     */
+    struct Problem {
+      Problem() = default;
+      Problem(const Problem&) = delete;
+      Problem& operator=(const Problem&) = delete;
+
+      Subproblem sp1d, sp2d;
+    };
 
   public:
     Solver(const Params& params = {});
@@ -42,29 +283,266 @@ namespace admm {
                 const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
                 const Eigen::MatrixXd& adj);
 
+    /**
+     * @brief      Designs the gains within a time budget. If ADMM has not
+     *             converged by then, the last iterate is projected onto the
+     *             linear constraints (as usual) and returned.
+     *
+     * @param[in]  pts       Desired formation points (3 x n)
+     * @param[in]  adj       Formation graph adjacency matrix
+     * @param[in]  deadline  Time budget (ms), or 0 for none
+     * @param[out] quality   Quality of the returned gains
+     *
+     * @return     The gain matrix
+     */
+    Eigen::MatrixXd solve(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) override;
+
+    /**
+     * @brief      Designs the gains, keeping only the diagonal and edge
+     *             blocks (see BlockGainMat)
+     */
+    BlockGainMat solveBlocks(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj);
+    BlockGainMat solveBlocks(
+                const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, double deadline,
+                Quality& quality) override;
+
+    const char * name() const override { return "admm"; }
+
+    /**
+     * @brief      Sets up both gain design subproblems of a formation, i.e.,
+     *             parses, equilibrates and factorizes them, for solves of
+     *             this or other solvers with the same parameters.
+     *
+     * @param[in]  pts       Desired formation points (3 x n)
+     * @param[in]  adj       Formation graph adjacency matrix
+     * @param[out] problem   The subproblems. n.b., until the next setup,
+     *                       its operators may refer to this solver.
+     */
+    void setup(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                const Eigen::MatrixXd& adj, Problem& problem);
+
+    /**
+     * @brief      Designs the gains of a formation that was set up already,
+     *             with the warm start and buffers of this solver. Neither
+     *             reads nor fills the gain cache.
+     *
+     * @param[in]  problem   Subproblems of the formation (see setup)
+     * @param[in]  deadline  Time budget (ms), or 0 for none
+     * @param[out] quality   Quality of the returned gains
+     *
+     * @return     The gain matrix
+     */
+    Eigen::MatrixXd solve(const Problem& problem, double deadline,
+                          Quality& quality);
+
+    /**
+     * @brief      Designs the gains of a formation that was set up already,
+     *             keeping only the diagonal and edge blocks (see solve)
+     *
+     * @param[in]  problem   Subproblems of the formation (see setup)
+     * @param[in]  adj       Formation graph adjacency matrix
+     * @param[in]  deadline  Time budget (ms), or 0 for none
+     * @param[out] quality   Quality of the returned gains
+     */
+    BlockGainMat solveBlocks(const Problem& problem,
+                             const Eigen::MatrixXd& adj, double deadline,
+                             Quality& quality);
+
+    /**
+     * @brief      Stops the ADMM iterations of a solve once the flag is set
+     *             (e.g., by another thread), like a deadline that has passed.
+     *             It is polled once per iteration.
+     *
+     * @param[in]  cancel  The flag, or nullptr to never cancel
+     */
+    void setCancelFlag(const std::atomic<bool> * cancel) { cancel_ = cancel; }
+
+    /**
+     * @brief      Forget the warm start state of previous solves
+     */
+    void resetWarmStart();
+
+    const GainCache& gainCache() const { return cache_; }
+
+    const Stats& stats1d() const { return stats1d_; }
+    const Stats& stats2d() const { return stats2d_; }
+
   private:
     Params params_;
 
-    using SpMat = Eigen::SparseMatrix<double>;
+    /// \brief Gains of recently designed formations
+    GainCache cache_;
+
+    /// \brief Set by another thread to cut a solve short (see setCancelFlag)
+    const std::atomic<bool> * cancel_ = nullptr;
+
+    /**
+     * @brief      Number of threads used to assemble an n-agent gain matrix
+     */
+    size_t numThreads(size_t n) const;
+
+    /// \brief Warm start state of each gain design subproblem
+    WarmStart ws1d_, ws2d_;
 
-    Eigen::MatrixXd solve1d(
-                    const Eigen::Matrix<double, 1, Eigen::Dynamic>& pts,
-                    const Eigen::MatrixXd& adj);
+    /// \brief Factorization of A*A' for each gain design subproblem
+    FactorCache fc1d_, fc2d_;
 
-    Eigen::MatrixXd solve2d(
-                    const Eigen::Matrix<double, 2, Eigen::Dynamic>& pts,
-                    const Eigen::MatrixXd& adj);
+    /// \brief Convergence of the last solve of each gain design subproblem
+    Stats stats1d_, stats2d_;
 
+    /// \brief ADMM buffers of each gain design subproblem
+    Workspace work1d_, work2d_;
+
+    /// \brief Solves one subproblem before the given deadline
+    using Subsolve = std::function<Eigen::MatrixXd(Clock::time_point)>;
+
+    /**
+     * @brief      Sets up and solves both subproblems of a formation
+     *
+     * @param[out] A2d   Gains of the 2D subproblem (2n x 2n)
+     * @param[out] A1d   Gains of the 1D subproblem (n x n)
+     */
+    void solveFormation(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality,
+                        Eigen::MatrixXd& A2d, Eigen::MatrixXd& A1d);
+
+    /**
+     * @brief      Splits the time budget between both subproblems and solves
+     *             them (in parallel, see Params::parallel)
+     */
+    void solveSubproblems(double deadline, Quality& quality,
+                          const Subsolve& solve1d, const Subsolve& solve2d,
+                          Eigen::MatrixXd& A2d, Eigen::MatrixXd& A1d);
+
+    /**
+     * @brief      Interleaves the gains of both subproblems into the
+     *             3n x 3n gain matrix
+     */
+    Eigen::MatrixXd interleave(const Eigen::MatrixXd& A2d,
+                                const Eigen::MatrixXd& A1d) const;
+
+    /**
+     * @brief      Interleaves the gains of both subproblems into only the
+     *             diagonal and edge blocks (see BlockGainMat)
+     */
+    BlockGainMat interleaveBlocks(const Eigen::MatrixXd& A2d,
+                                  const Eigen::MatrixXd& A1d,
+                                  const Eigen::MatrixXd& adj) const;
+
+    void setup1d(const Eigen::Matrix<double, 1, Eigen::Dynamic>& pts,
+                  const Eigen::MatrixXd& adj, Subproblem& sp);
+
+    void setup2d(const Eigen::Matrix<double, 2, Eigen::Dynamic>& pts,
+                  const Eigen::MatrixXd& adj, Subproblem& sp);
+
+    /**
+     * @brief      Parses, equilibrates and factorizes a subproblem whose
+     *             d, m, n, adj and Q are set
+     */
+    void setup(Subproblem& sp, FactorCache& fc);
+
+    /**
+     * @brief      Solves a subproblem that was set up
+     *
+     * @return     The gains of the subproblem, i.e., -Q \bar{A} Q'
+     */
+    Eigen::MatrixXd design(const Subproblem& sp, WarmStart& ws,
+                            Workspace& work, Stats& stats,
+                            Clock::time_point deadline);
+
+    /**
+     * @brief      Solves a gain design subproblem with LowRank (see
+     *             Params::lowRank)
+     *
+     * @return     X = [tI I; I \bar{A}] with the smallest t for \bar{A}
+     */
+    Iterate designLowRank(const Subproblem& sp, Stats& stats,
+                          Clock::time_point deadline, Telemetry* tel);
+
+    /**
+     * @brief      Projects W onto the PSD cone
+     *
+     * @param[in]  W       Symmetric matrix
+     * @param      S       Projection
+     */
+    void projectPSD(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                    Formulation f, Workspace& work);
+    void projectPSDDense(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>& es,
+                    Eigen::MatrixXd& V);
+    void projectPSDHermitian(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                              Workspace& work);
+
+    /**
+     * @brief      Formulation of the subproblem of ambient dimension d
+     */
+    Formulation formulation(size_t d) const;
+
+    /**
+     * @brief      Builds C, A, b and the initial X of a gain design SDP
+     *
+     * @tparam     D     Ambient dimension (1 or 2), or Eigen::Dynamic to
+     *                   take it from d at runtime
+     */
+    template <int D>
     void parse(size_t d, size_t m, size_t n,
                 const Eigen::MatrixXd& adj, const Eigen::MatrixXd& Q,
-                SpMat& C, SpMat& A, SpMat& b, SpMat& X);
+                SpMat& C, SpMat& A, SpMat& b, SpMat& X,
+                std::vector<Constraints::GraphRow> * graph = nullptr);
+
+    /**
+     * @brief      Builds C = [I 0; 0 0] and the initial X = [I I; I I]
+     */
+    void initialize(size_t dm, SpMat& C, SpMat& X);
 
-    void admm(const SpMat& C, const SpMat& A, const SpMat& b, SpMat& X);
+    /**
+     * @brief      Ruiz equilibration of C, A and b of the Hermitian
+     *             formulation (see Params::equilibrate)
+     *
+     * @param[out] scale The row scaling R and D, i.e., X = D \tilde{X} D
+     */
+    void equilibrate(SpMat& C, SpMat& A, SpMat& b, Scaling& scale);
 
-    inline void vectorize(const SpMat& X, SpMat& x);
-    inline void unvectorize(const SpMat& X, SpMat& x);
+    void factorize(size_t d, size_t n, const Eigen::MatrixXd& adj,
+                    const SpMat& A, FactorCache& fc);
+
+    void admm(const SpMat& C, const Constraints& A, const SpMat& b,
+                Formulation f, Workspace& work, Iterate& X, Iterate& S,
+                Stats& stats,
+                Clock::time_point deadline, Telemetry* tel = nullptr,
+                const Scaling * scale = nullptr);
+
+    void applyWarmStart(const WarmStart& ws, const Eigen::MatrixXd& Q,
+                        Iterate& X, Iterate& S);
+    void storeWarmStart(const Eigen::MatrixXd& Q, const Iterate& X,
+                        const Iterate& S, WarmStart& ws);
+
+    /// \brief In place, into vectors/matrices of the right size
+    inline void vectorize(const Eigen::MatrixXd& X, Eigen::VectorXd& x,
+                          Formulation f);
+    inline void unvectorize(const Eigen::VectorXd& x, Eigen::MatrixXd& X,
+                            Formulation f);
     inline size_t blksel(size_t dim, size_t blkidx, size_t subidx);
     inline size_t vecsel(size_t rows, size_t cols, size_t i, size_t j);
+    inline size_t svecsel(size_t i, size_t j);
+    inline size_t hermsel(size_t k, size_t l, size_t part);
+
+    /**
+     * @brief      Reduces the triplets of vec(X) constraint rows to the
+     *             parameters of the Hermitian formulation and removes rows
+     *             that become zero or repeated.
+     */
+    void reduceHermitian(size_t N, size_t rows,
+                          std::vector<Eigen::Triplet<double>>& Acoeffs,
+                          std::vector<Eigen::Triplet<double>>& bcoeffs,
+                          SpMat& A, SpMat& b);
   };
 
 
@@ -0,0 +1,59 @@
+/**
+ * @file telemetry.h
+ * @brief Per-iteration telemetry of the ADMM-based formation gain solver
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+  /**
+   * @brief      Timing breakdown (ms) and convergence of one ADMM iteration
+   */
+  struct IterationTelemetry {
+    double tY = 0; ///< y-update: vectorize, A*x and solve with A*A'
+    double tEig = 0; ///< eigendecomposition / projection onto PSD cone
+    double tUpdate = 0; ///< A'y, forming W, X update (and acceleration)
+    double tStop = 0; ///< residuals and stopping criteria
+    double primalRes = 0; ///< ||A(X) - b|| / (1 + ||b||)
+    double dualRes = 0; ///< ||C - A'y - S|| / (1 + ||C||)
+    double trErr = 0; ///< (Tr[\bar{A}] - dm) / dm
+    double mu = 0; ///< penalty used in this iteration
+  };
+
+  /**
+   * @brief      Telemetry of the solve of one gain design subproblem
+   */
+  struct Telemetry {
+    size_t d = 0; ///< ambient dimension of the subproblem (1 or 2)
+    size_t n = 0; ///< number of vehicles
+    size_t dimX = 0; ///< dimension of the decision variable X (2dm)
+    size_t rowsA = 0; ///< number of constraints
+    size_t nnzA = 0; ///< stored coefficients of the constraint operator
+    double tParse = 0; ///< building C, A, b (ms)
+    double tFactorize = 0; ///< factorization of A*A' or operator setup (ms)
+    double tProject = 0; ///< final projection onto A(X) = b (ms)
+    double tTotal = 0; ///< whole subproblem, including the above (ms)
+    std::vector<IterationTelemetry> iterations;
+  };
+
+namespace telemetry {
+
+  /// \brief Wall time since a given start, in milliseconds
+  inline double elapsedMs(const std::chrono::steady_clock::time_point& start)
+  {
+    const auto dt = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::milli>(dt).count();
+  }
+
+} // ns telemetry
+} // ns admm
+} // ns aclswarm
+} // ns acl
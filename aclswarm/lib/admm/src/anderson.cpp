@@ -0,0 +1,79 @@
+/**
+ * @file anderson.cpp
+ * @brief Anderson acceleration of a fixed-point iteration
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <Eigen/Dense>
+
+#include "admm/anderson.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+Anderson::Anderson(size_t mem, double reg)
+: mem_(mem), reg_(reg)
+{
+
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::VectorXd Anderson::step(const Eigen::VectorXd& z,
+                               const Eigen::VectorXd& Tz)
+{
+  const Eigen::VectorXd g = Tz - z;
+
+  // no history yet (or the problem size changed)
+  if (gPrev_.size() != g.size()) {
+    dG_.resize(g.size(), mem_);
+    dF_.resize(g.size(), mem_);
+    k_ = head_ = 0;
+    gPrev_ = g;
+    TzPrev_ = Tz;
+    return Tz;
+  }
+
+  // safeguard: the combination made things worse, start over
+  if (g.squaredNorm() >= gPrev_.squaredNorm()) {
+    if (k_ > 0) ++restarts_;
+    k_ = head_ = 0;
+    gPrev_ = g;
+    TzPrev_ = Tz;
+    return Tz;
+  }
+
+  // add the newest differences, overwriting the oldest if full
+  const size_t col = (head_ + k_) % mem_;
+  dG_.col(col) = g - gPrev_;
+  dF_.col(col) = Tz - TzPrev_;
+  if (k_ < mem_) ++k_;
+  else head_ = (head_ + 1) % mem_;
+
+  gPrev_ = g;
+  TzPrev_ = Tz;
+
+  // gamma = argmin || g - dG gamma ||, via regularized normal equations.
+  // Column order does not matter, so the whole (used) buffer is taken.
+  const Eigen::MatrixXd G = dG_.leftCols(k_);
+  Eigen::MatrixXd GtG = G.transpose() * G;
+  GtG.diagonal().array() += reg_ * (1.0 + GtG.diagonal().maxCoeff());
+  const Eigen::VectorXd gamma = GtG.ldlt().solve(G.transpose() * g);
+
+  return Tz - dF_.leftCols(k_) * gamma;
+}
+
+// ----------------------------------------------------------------------------
+
+void Anderson::reset()
+{
+  k_ = head_ = 0;
+  gPrev_.resize(0);
+  TzPrev_.resize(0);
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,74 @@
+/**
+ * @file batch_solver.cpp
+ * @brief Gain design of many formations on a pool of worker threads
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "admm/batch_solver.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+BatchSolver::BatchSolver(const Params& params, size_t numWorkers)
+{
+  if (numWorkers == 0) numWorkers = std::thread::hardware_concurrency();
+  numWorkers = std::max<size_t>(numWorkers, 1);
+
+  Params p = params;
+  p.warmStart = false; // depends on the previous problem of the worker
+  p.cacheSize = 0; // depends on which problems the worker has seen
+  p.parallel = false; // the pool already keeps the cores busy
+
+  solvers_.reserve(numWorkers);
+  for (size_t i=0; i<numWorkers; ++i) solvers_.emplace_back(new Solver(p));
+}
+
+// ----------------------------------------------------------------------------
+
+std::vector<Eigen::MatrixXd> BatchSolver::solve(
+                                        const std::vector<Problem>& problems)
+{
+  std::vector<Eigen::MatrixXd> gains(problems.size());
+
+  std::atomic<size_t> next(0);
+  std::exception_ptr error;
+  std::mutex mtx;
+
+  // each worker takes the next unsolved problem until there are none left
+  auto work = [&](Solver& solver) {
+    for (size_t i=next++; i<problems.size(); i=next++) {
+      try {
+        gains[i] = solver.solve(problems[i].pts, problems[i].adj);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!error) error = std::current_exception();
+      }
+    }
+  };
+
+  const size_t nthreads = std::min(solvers_.size(), problems.size());
+  std::vector<std::thread> workers;
+  workers.reserve(nthreads);
+  for (size_t t=1; t<nthreads; ++t) {
+    workers.emplace_back(work, std::ref(*solvers_[t]));
+  }
+  if (nthreads > 0) work(*solvers_[0]);
+  for (auto& w : workers) w.join();
+
+  if (error) std::rethrow_exception(error);
+
+  return gains;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,89 @@
+/**
+ * @file block_gain_mat.cpp
+ * @brief Symmetric block-sparse storage of a formation gain matrix
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+
+#include "admm/block_gain_mat.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+BlockGainMat::BlockGainMat(const Eigen::MatrixXd& adj)
+: n_(adj.rows()), diag_(n_, Eigen::Matrix3d::Zero())
+{
+  rowPtr_.reserve(n_ + 1);
+  rowPtr_.push_back(0);
+  for (size_t i=0; i<n_; ++i) {
+    for (size_t j=i+1; j<n_; ++j) {
+      if (adj(i,j) != 0) cols_.push_back(j);
+    }
+    rowPtr_.push_back(cols_.size());
+  }
+  upper_.resize(cols_.size(), Eigen::Matrix3d::Zero());
+}
+
+// ----------------------------------------------------------------------------
+
+BlockGainMat BlockGainMat::fromDense(const Eigen::MatrixXd& A,
+                                     const Eigen::MatrixXd& adj)
+{
+  BlockGainMat G(adj);
+  for (size_t i=0; i<G.n_; ++i) {
+    G.diag_[i] = A.block<3,3>(3*i, 3*i);
+    for (size_t k=G.rowPtr_[i]; k<G.rowPtr_[i+1]; ++k) {
+      G.upper_[k] = A.block<3,3>(3*i, 3*G.cols_[k]);
+    }
+  }
+  return G;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd BlockGainMat::toDense() const
+{
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(3*n_, 3*n_);
+  for (size_t i=0; i<n_; ++i) {
+    A.block<3,3>(3*i, 3*i) = diag_[i];
+    for (size_t k=rowPtr_[i]; k<rowPtr_[i+1]; ++k) {
+      const size_t j = cols_[k];
+      A.block<3,3>(3*i, 3*j) = upper_[k];
+      A.block<3,3>(3*j, 3*i) = upper_[k].transpose();
+    }
+  }
+  return A;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::Matrix3d BlockGainMat::block(size_t i, size_t j) const
+{
+  if (i == j) return diag_[i];
+
+  const int k = (i < j) ? find(i, j) : find(j, i);
+  if (k < 0) return Eigen::Matrix3d::Zero();
+
+  if (i < j) return upper_[k];
+  return upper_[k].transpose();
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+int BlockGainMat::find(size_t i, size_t j) const
+{
+  const auto first = cols_.begin() + rowPtr_[i];
+  const auto last = cols_.begin() + rowPtr_[i+1];
+  const auto it = std::lower_bound(first, last, j);
+  if (it == last || *it != j) return -1;
+  return it - cols_.begin();
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
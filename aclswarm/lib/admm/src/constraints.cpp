@@ -0,0 +1,191 @@
+/**
+ * @file constraints.cpp
+ * @brief Linear constraint operator of the ADMM gain design SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include "admm/constraints.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+Constraints::Constraints(const SpMat& A, const Cholesky& AAs)
+: mode_(Mode::Explicit), rows_(A.rows()), cols_(A.cols()), A_(&A),
+  At_(A.adjoint()), AAs_(&AAs)
+{
+
+}
+
+// ----------------------------------------------------------------------------
+
+Constraints::Constraints(const SpMat& As, const std::vector<GraphRow>& graph,
+                          const Eigen::MatrixXd& Q, double cgTol,
+                          size_t cgMaxItr)
+: mode_(Mode::MatrixFree), rows_(As.rows() + graph.size()), cols_(As.cols()),
+  As_(As), Ast_(As.adjoint()), graph_(graph), Q_(Q),
+  N_(2*Q.cols()), dm_(Q.cols()), cgTol_(cgTol), cgMaxItr_(cgMaxItr)
+{
+  // Jacobi preconditioner. The squared norm of a graph row is
+  // ||q_j||^2 * ||q_i||^2, since its coefficients are q_j q_i'.
+  precond_ = Eigen::VectorXd::Ones(rows_);
+  for (int r=0; r<As_.rows(); ++r) {
+    const double nrm = Ast_.col(r).squaredNorm();
+    if (nrm > 0) precond_(r) = 1.0 / nrm;
+  }
+  const Eigen::VectorXd qnorm = Q_.rowwise().squaredNorm();
+  for (size_t k=0; k<graph_.size(); ++k) {
+    const double nrm = qnorm(graph_[k].second) * qnorm(graph_[k].first);
+    if (nrm > 0) precond_(As_.rows() + k) = 1.0 / nrm;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Constraints::Constraints(const NullSpace& ns)
+: mode_(Mode::NullSpace), rows_(ns.ambient()), cols_(rows_),
+  ns_(&ns)
+{
+
+}
+
+// ----------------------------------------------------------------------------
+
+size_t Constraints::storage() const
+{
+  if (mode_ == Mode::Explicit) return A_->nonZeros();
+  if (mode_ == Mode::NullSpace) return ns_->storage();
+  return As_.nonZeros() + Q_.size();
+}
+
+// ----------------------------------------------------------------------------
+
+void Constraints::apply(const Eigen::VectorXd& x, Eigen::VectorXd& Ax,
+                        NullSpace::Scratch& scratch) const
+{
+  if (mode_ == Mode::Explicit) {
+    Ax.noalias() = (*A_) * x;
+    return;
+  }
+
+  if (mode_ == Mode::NullSpace) {
+    ns_->project(x, Ax, scratch);
+    Ax = x - Ax;
+    return;
+  }
+
+  applyDense(x, Ax);
+}
+
+// ----------------------------------------------------------------------------
+
+void Constraints::applyAdjoint(const Eigen::VectorXd& y,
+                                Eigen::VectorXd& Aty,
+                                NullSpace::Scratch& scratch) const
+{
+  if (mode_ == Mode::Explicit) {
+    Aty.noalias() = At_ * y;
+    return;
+  }
+
+  // the projector is self-adjoint
+  if (mode_ == Mode::NullSpace) {
+    apply(y, Aty, scratch);
+    return;
+  }
+
+  applyAdjointDense(y, Aty);
+}
+
+// ----------------------------------------------------------------------------
+
+void Constraints::solveNormal(const Eigen::VectorXd& e,
+                              Eigen::VectorXd& y) const
+{
+  if (mode_ == Mode::Explicit) {
+    y = AAs_->solve(e);
+    return;
+  }
+
+  // A*A' = A is the identity on its range, where ADMM's e = A(x) + mu*b is
+  if (mode_ == Mode::NullSpace) {
+    y = e;
+    return;
+  }
+
+  //
+  // Preconditioned conjugate gradient on (A*A') y = e
+  //
+
+  const Eigen::VectorXd& b = e;
+  y.setZero(rows_);
+  Eigen::VectorXd r = b;
+  Eigen::VectorXd z = precond_.cwiseProduct(r);
+  Eigen::VectorXd p = z;
+  Eigen::VectorXd Atp, AAtp;
+
+  const double bnorm = b.norm();
+  double rz = r.dot(z);
+
+  for (size_t k=0; k<cgMaxItr_ && r.norm() > cgTol_ * bnorm; ++k) {
+    applyAdjointDense(p, Atp);
+    applyDense(Atp, AAtp);
+
+    const double pAp = p.dot(AAtp);
+    if (pAp <= 0) break; // p is in the nullspace of A' (redundant rows)
+
+    const double alpha = rz / pAp;
+    y += alpha * p;
+    r -= alpha * AAtp;
+
+    z = precond_.cwiseProduct(r);
+    const double rzold = rz;
+    rz = r.dot(z);
+    p = z + (rz / rzold) * p;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+void Constraints::applyDense(const Eigen::VectorXd& x,
+                              Eigen::VectorXd& Ax) const
+{
+  Ax.resize(rows_);
+  Ax.head(As_.rows()) = As_ * x;
+
+  if (graph_.empty()) return;
+
+  // [A_ij] of the gain matrix, for all i,j: Q \bar{X} Q'
+  Eigen::Map<const Eigen::MatrixXd> X(x.data(), N_, N_);
+  const Eigen::MatrixXd M = Q_ * X.bottomRightCorner(dm_, dm_) * Q_.transpose();
+
+  for (size_t k=0; k<graph_.size(); ++k) {
+    Ax(As_.rows() + k) = M(graph_[k].second, graph_[k].first);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Constraints::applyAdjointDense(const Eigen::VectorXd& y,
+                                    Eigen::VectorXd& Aty) const
+{
+  Aty = Ast_ * y.head(As_.rows());
+
+  if (graph_.empty()) return;
+
+  // sum_k y_k q_j q_i' = Q' Y Q, where Y has y_k at (j,i)
+  Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(Q_.rows(), Q_.rows());
+  for (size_t k=0; k<graph_.size(); ++k) {
+    Y(graph_[k].second, graph_[k].first) += y(As_.rows() + k);
+  }
+
+  Eigen::Map<Eigen::MatrixXd> X(Aty.data(), N_, N_);
+  X.bottomRightCorner(dm_, dm_) += Q_.transpose() * Y * Q_;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
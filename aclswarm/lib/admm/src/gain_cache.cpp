@@ -0,0 +1,157 @@
+/**
+ * @file gain_cache.cpp
+ * @brief LRU cache of designed gains, keyed by formation shape
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cmath>
+#include <functional>
+
+#include "admm/gain_cache.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+GainCache::GainCache(size_t capacity, double quantum, double thrPlanar)
+: capacity_(capacity), quantum_(quantum), thrPlanar_(thrPlanar)
+{
+
+}
+
+// ----------------------------------------------------------------------------
+
+bool GainCache::find(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                     const Eigen::MatrixXd& adj, BlockGainMat& gains)
+{
+  const auto it = index_.find(makeKey(pts, adj));
+  if (it == index_.end()) {
+    ++misses_;
+    return false;
+  }
+
+  // mark as most recently used
+  entries_.splice(entries_.begin(), entries_, it->second);
+  gains = it->second->second;
+  ++hits_;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
+void GainCache::insert(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                       const Eigen::MatrixXd& adj, const BlockGainMat& gains)
+{
+  if (capacity_ == 0) return;
+
+  Key key = makeKey(pts, adj);
+
+  const auto it = index_.find(key);
+  if (it != index_.end()) {
+    it->second->second = gains;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+
+  entries_.emplace_front(std::move(key), gains);
+  index_[entries_.front().first] = entries_.begin();
+}
+
+// ----------------------------------------------------------------------------
+
+void GainCache::clear()
+{
+  entries_.clear();
+  index_.clear();
+  hits_ = misses_ = 0;
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+size_t GainCache::KeyHash::operator()(const Key& key) const
+{
+  // boost::hash_combine
+  size_t seed = key.size();
+  for (const auto& k : key) {
+    seed ^= std::hash<int64_t>()(k) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+// ----------------------------------------------------------------------------
+
+GainCache::Key GainCache::makeKey(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj) const
+{
+  const size_t n = pts.cols();
+
+  //
+  // Canonical xy: centered, rotated about z, unit RMS radius
+  //
+
+  const Eigen::Vector2d centroid = pts.topRows(2).rowwise().mean();
+  Eigen::Matrix<double, 2, Eigen::Dynamic> qxy =
+                                      pts.topRows(2).colwise() - centroid;
+
+  const Eigen::VectorXd r = qxy.colwise().norm();
+  const double rms = std::sqrt(r.squaredNorm() / n);
+  if (rms > 0) {
+    qxy /= rms;
+
+    // rotate the first agent that is not at the centroid onto +x. Agents are
+    // labeled (the graph is part of the key), so this is well-defined.
+    for (size_t i=0; i<n; ++i) {
+      if (r(i) / rms > std::sqrt(quantum_)) {
+        const double th = std::atan2(qxy(1,i), qxy(0,i));
+        Eigen::Matrix2d R;
+        R << std::cos(th), std::sin(th), -std::sin(th), std::cos(th);
+        qxy = R * qxy;
+        break;
+      }
+    }
+  }
+
+  //
+  // Canonical z: same test for flat planar formations as the 1D subproblem
+  //
+
+  Eigen::RowVectorXd qz = pts.row(2);
+  const double stdev = std::sqrt((qz.array() - qz.mean()).square().sum()/(n-1));
+  const bool xyflat = (stdev < thrPlanar_);
+  if (xyflat) qz.setZero();
+  else qz = (qz.array() - qz.mean()) / stdev;
+
+  //
+  // Quantize
+  //
+
+  Key key;
+  key.reserve(2 + n*n + 3*n);
+  key.push_back(n);
+  key.push_back(xyflat);
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<n; ++j) {
+      key.push_back(adj(i,j) != 0);
+    }
+  }
+  for (size_t i=0; i<n; ++i) {
+    key.push_back(std::llround(qxy(0,i) / quantum_));
+    key.push_back(std::llround(qxy(1,i) / quantum_));
+    key.push_back(std::llround(qz(i) / quantum_));
+  }
+
+  return key;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
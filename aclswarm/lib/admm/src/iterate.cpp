@@ -0,0 +1,54 @@
+/**
+ * @file iterate.cpp
+ * @brief Hybrid sparse/dense storage of an ADMM iterate
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include "admm/iterate.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+void Iterate::assign(const Eigen::MatrixXd& X, double maxFill)
+{
+  const size_t nnz = (X.array() != 0).count();
+  dense_ = nnz > maxFill * X.size();
+
+  if (dense_) {
+    D_ = X;
+    sparse_ = SpMat();
+  } else {
+    sparse_ = X.sparseView();
+    D_.resize(0, 0);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Iterate::copyTo(Eigen::MatrixXd& X) const
+{
+  if (dense_) X = D_;
+  else X = sparse_;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Iterate::bottomRightCorner(size_t k) const
+{
+  if (dense_) return D_.bottomRightCorner(k, k);
+  return Eigen::MatrixXd(sparse_.bottomRightCorner(k, k));
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Iterate::congruence(const Eigen::MatrixXd& T) const
+{
+  if (dense_) return T.transpose() * D_ * T;
+  return T.transpose() * sparse_ * T;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
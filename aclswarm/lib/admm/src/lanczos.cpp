@@ -0,0 +1,141 @@
+/**
+ * @file lanczos.cpp
+ * @brief Partial symmetric eigendecomposition via restarted Lanczos
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cmath>
+
+#include <Eigen/Eigenvalues>
+
+#include "admm/lanczos.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+// orthogonalize v against the first k columns of B and the first l columns
+// of C. Twice is enough. Alternating matters: removing the components along B
+// reintroduces (round-off) components along C, which would grow each step.
+static void orthogonalize(const Eigen::MatrixXd& B, size_t k,
+                          const Eigen::MatrixXd& C, size_t l,
+                          Eigen::VectorXd& v)
+{
+  for (size_t pass=0; pass<2; ++pass) {
+    if (k > 0) v -= B.leftCols(k) * (B.leftCols(k).transpose() * v);
+    if (l > 0) v -= C.leftCols(l) * (C.leftCols(l).transpose() * v);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+bool lanczosAbove(const Eigen::MatrixXd& W, double thresh, size_t maxModes,
+                  double tol, Eigen::VectorXd& evals, Eigen::MatrixXd& evecs)
+{
+  const size_t N = W.rows();
+
+  // converged (deflated) eigenpairs
+  Eigen::MatrixXd V(N, maxModes + 1);
+  Eigen::VectorXd D(maxModes + 1);
+  size_t nconv = 0;
+
+  // scale for convergence tolerance
+  const double Wnorm = std::max(W.cwiseAbs().rowwise().sum().maxCoeff(), 1e-300);
+
+  // Lanczos vectors and tridiagonal coefficients
+  Eigen::MatrixXd K(N, N);
+  Eigen::VectorXd alpha(N), beta(N);
+
+  // Budget: 2N matrix-vector products (and the reorthogonalization that
+  // comes with them) cost about as much as a dense eigendecomposition.
+  size_t budget = 2*N;
+  size_t restart = 0;
+
+  while (true) {
+
+    //
+    // Deterministic start vector, orthogonal to the deflated subspace
+    //
+
+    const size_t kmax = N - nconv;
+    if (kmax == 0) break;
+
+    Eigen::VectorXd v = Eigen::VectorXd::Ones(N);
+    for (size_t i=0; i<N; ++i) v(i) += std::sin(1.0 + i * (restart + 1));
+    orthogonalize(V, nconv, K, 0, v);
+    for (size_t i=0; v.norm() < 1e-8 && i<N; ++i) {
+      v = Eigen::VectorXd::Unit(N, i);
+      orthogonalize(V, nconv, K, 0, v);
+    }
+    if (v.norm() < 1e-8) break;
+    K.col(0) = v.normalized();
+    restart++;
+
+    //
+    // Lanczos iterations with full reorthogonalization
+    //
+
+    Eigen::VectorXd theta; // Ritz values of this run
+    Eigen::MatrixXd Sk; // eigenvectors of tridiagonal
+    Eigen::VectorXd res; // Ritz residuals
+    size_t k = 0;
+    bool done = false;
+    while (!done) {
+      if (budget == 0) return false;
+      budget--;
+
+      Eigen::VectorXd w = W * K.col(k);
+      alpha(k) = K.col(k).dot(w);
+      orthogonalize(K, k+1, V, nconv, w);
+      beta(k) = w.norm();
+      k++;
+
+      const bool invariant = (beta(k-1) < tol * Wnorm) || k == kmax;
+
+      // the Ritz values need not be checked every iteration
+      if (invariant || k % 4 == 0) {
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+        Eigen::VectorXd subdiag = beta.head(k-1);
+        es.computeFromTridiagonal(alpha.head(k), subdiag);
+        theta = es.eigenvalues();
+        Sk = es.eigenvectors();
+        res = (beta(k-1) * Sk.row(k-1)).cwiseAbs().transpose();
+
+        // Done with this run once the dominant Ritz value converged.
+        // Others that converged along the way are deflated too.
+        done = invariant || res(k-1) < tol * Wnorm;
+      }
+
+      if (!done) K.col(k) = w / beta(k-1);
+    }
+
+    //
+    // Deflate converged Ritz pairs above the threshold
+    //
+
+    size_t nnew = 0;
+    for (size_t i=0; i<k; ++i) {
+      if (theta(i) <= thresh || res(i) >= tol * Wnorm) continue;
+      if (nconv == maxModes) return false;
+
+      Eigen::VectorXd u = K.leftCols(k) * Sk.col(i);
+      orthogonalize(V, nconv, K, 0, u);
+      V.col(nconv) = u.normalized();
+      D(nconv) = theta(i);
+      nconv++;
+      nnew++;
+    }
+
+    // the dominant remaining eigenvalue is below the threshold
+    if (nnew == 0) break;
+  }
+
+  evals = D.head(nconv);
+  evecs = V.leftCols(nconv);
+  return true;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,180 @@
+/**
+ * @file low_rank.cpp
+ * @brief Burer-Monteiro solver of the dual of the gain design SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "admm/low_rank.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+LowRank::LowRank(const NullSpace& ns, const Eigen::MatrixXd& Q, size_t rank,
+                  double sigma)
+: ns_(ns), Q_(Q), sigma_(sigma)
+{
+  const size_t dm = Q.cols();
+  rank = std::max<size_t>(1, std::min(rank, dm));
+
+  // starts from the feasible \bar{A} of least norm
+  w_ = ns_.particularGains();
+
+  // n.b., a fixed seed keeps solves deterministic
+  std::mt19937 gen(0);
+  std::normal_distribution<double> normal;
+  V_.resize(dm, rank);
+  for (int i=0; i<V_.size(); ++i) V_.data()[i] = normal(gen);
+  V_ /= V_.norm();
+
+  f_ = evaluate(V_, e_, c_);
+  fhist_.assign(1, f_);
+  gradient(rgrad_);
+
+  // |\bar{A}| bounds the curvature of the objective, sigma that of the
+  // penalty (P_S is an orthogonal projection)
+  eta_ = 1.0 / (2 * (w_.norm() + sigma_));
+}
+
+// ----------------------------------------------------------------------------
+
+double LowRank::step()
+{
+  const double gnorm2 = rgrad_.squaredNorm();
+
+  // Barzilai-Borwein step length from the last accepted step
+  if (bb_) {
+    const double ss = (V_ - Vprev_).squaredNorm();
+    const double sy = std::abs((V_ - Vprev_).cwiseProduct(
+                                              rgrad_ - rgradPrev_).sum());
+    if (sy > 0) eta_ = std::min(std::max(ss / sy, 1e-8), 1e8);
+  }
+
+  // Armijo backtracking along the retraction onto the sphere. n.b., against
+  // the largest of the last few values (nonmonotone), which BB steps need.
+  static constexpr double armijo = 1e-4;
+  static constexpr size_t maxBacktrack = 30;
+  const double fref = *std::max_element(fhist_.begin(), fhist_.end());
+  for (size_t k=0; k<maxBacktrack; ++k) {
+    Vnew_ = V_ - eta_ * rgrad_;
+    Vnew_ /= Vnew_.norm();
+
+    const double f = evaluate(Vnew_, eTry_, cTry_);
+    if (f <= fref - armijo * eta_ * gnorm2) {
+      Vprev_.swap(V_);
+      V_.swap(Vnew_);
+      rgradPrev_.swap(rgrad_);
+      e_.swap(eTry_);
+      c_.swap(cTry_);
+      f_ = f;
+      if (fhist_.size() == memory) fhist_.pop_front();
+      fhist_.push_back(f_);
+      gradient(rgrad_);
+      bb_ = true;
+      return std::sqrt(gnorm2);
+    }
+    eta_ *= 0.5;
+  }
+
+  // no decrease within roundoff, i.e., V is stationary
+  evaluate(V_, e_, c_);
+  bb_ = false;
+  return std::sqrt(gnorm2);
+}
+
+// ----------------------------------------------------------------------------
+
+void LowRank::updateMultiplier()
+{
+  w_ += sigma_ * c_;
+
+  // the objective changed, the last step says nothing about its curvature
+  f_ = evaluate(V_, e_, c_);
+  fhist_.assign(1, f_);
+  gradient(rgrad_);
+  bb_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+void LowRank::escape(const Eigen::MatrixXd& U, double theta)
+{
+  // n.b., |V| stays 1 since U is orthonormal
+  Eigen::MatrixXd V(V_.rows(), V_.cols() + U.cols());
+  V << std::sqrt(1 - theta) * V_, std::sqrt(theta / U.cols()) * U;
+  V_.swap(V);
+
+  f_ = evaluate(V_, e_, c_);
+  fhist_.assign(1, f_);
+  gradient(rgrad_);
+  bb_ = false;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd LowRank::abar() const
+{
+  const size_t dn = Q_.rows();
+  const Eigen::VectorXd g = ns_.basis() * w_;
+  Eigen::Map<const Eigen::MatrixXd> G(g.data(), dn, dn);
+  return Q_.transpose() * G * Q_;
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+double LowRank::evaluate(const Eigen::MatrixXd& V, Eigen::VectorXd& e,
+                          Eigen::VectorXd& c) const
+{
+  const SpMat& E = ns_.basis();
+  const size_t dn = Q_.rows();
+
+  // (QV)', so that the rows of QV are contiguous
+  Tt_.noalias() = V.transpose() * Q_.transpose();
+
+  // only the entries of (QV)(QV)' on the graph (the patterns of E)
+  e.setZero(E.cols());
+  for (int k=0; k<E.outerSize(); ++k) {
+    for (SpMat::InnerIterator it(E, k); it; ++it) {
+      const size_t p = it.row() % dn, q = it.row() / dn;
+      e(k) += it.value() * Tt_.col(p).dot(Tt_.col(q));
+    }
+  }
+
+  c = e;
+  ns_.projectGains(c, nsScratch_);
+
+  return w_.dot(e) + 0.5 * sigma_ * c.squaredNorm();
+}
+
+// ----------------------------------------------------------------------------
+
+void LowRank::gradient(Eigen::MatrixXd& rgrad) const
+{
+  const SpMat& E = ns_.basis();
+  const size_t dn = Q_.rows();
+
+  // (G QV)' for the gains G = E (w + sigma c), with Tt = (QV)' from evaluate
+  GTt_.setZero(Tt_.rows(), Tt_.cols());
+  for (int k=0; k<E.outerSize(); ++k) {
+    const double u = w_(k) + sigma_ * c_(k);
+    for (SpMat::InnerIterator it(E, k); it; ++it) {
+      const size_t p = it.row() % dn, q = it.row() / dn;
+      GTt_.col(p) += (it.value() * u) * Tt_.col(q);
+    }
+  }
+
+  // Euclidean gradient 2 Q'GQV, projected onto the tangent space at V
+  rgrad.noalias() = 2 * Q_.transpose() * GTt_.transpose();
+  rgrad -= rgrad.cwiseProduct(V_).sum() * V_;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
@@ -0,0 +1,195 @@
+/**
+ * @file null_space.cpp
+ * @brief Parametrization of the feasible affine subspace of the gain SDP
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <Eigen/QR>
+
+#include "admm/null_space.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+NullSpace::NullSpace(size_t d, const Eigen::MatrixXd& adj,
+                      const Eigen::MatrixXd& Q, double shift)
+: N_(2*Q.cols()), dm_(Q.cols()), Q_(Q)
+{
+  const size_t n = adj.rows();
+  const size_t dn = Q.rows();
+  const double s2 = 1.0 / std::sqrt(2.0);
+
+  //
+  // Orthonormal basis of symmetric gains supported on the graph
+  //
+
+  // Each column is one coordinate of G, i.e., a (scaled) pattern of entries
+  // of vec(G). The patterns are disjoint, so the columns are orthonormal.
+  std::vector<Eigen::Triplet<double>> coeffs;
+  coeffs.reserve(4*d*(n + (adj.array() != 0).count())); // upper bound
+  size_t k = 0;
+  auto add = [&](size_t p, size_t q, double w) {
+    coeffs.emplace_back(p + q*dn, k, w);
+  };
+
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=i; j<n; ++j) {
+      if (i != j && adj(i,j) == 0) continue;
+
+      if (d == 1) {
+        if (i == j) add(i, i, 1);
+        else { add(i, j, s2); add(j, i, s2); }
+        k++;
+        continue;
+      }
+
+      // 2D blocks are [a b; -b a], and b = 0 on the diagonal (symmetry)
+      const size_t i0 = 2*i, i1 = 2*i+1, j0 = 2*j, j1 = 2*j+1;
+      if (i == j) {
+        add(i0, i0, s2); add(i1, i1, s2);
+        k++;
+      } else {
+        add(i0, j0, 0.5); add(i1, j1, 0.5); add(j0, i0, 0.5); add(j1, i1, 0.5);
+        k++;
+        add(i0, j1, 0.5); add(i1, j0, -0.5); add(j1, i0, 0.5); add(j0, i1, -0.5);
+        k++;
+      }
+    }
+  }
+
+  E_.resize(dn*dn, k);
+  E_.setFromTriplets(coeffs.begin(), coeffs.end());
+  Et_ = E_.transpose();
+
+  //
+  // Kernel of the gain matrix, B g = vec(G K)
+  //
+
+  Eigen::HouseholderQR<Eigen::MatrixXd> qr(Q);
+  const Eigen::MatrixXd K = (qr.householderQ()
+                  * Eigen::MatrixXd::Identity(dn, dn)).rightCols(dn - dm_);
+
+  coeffs.clear();
+  coeffs.reserve(E_.nonZeros() * K.cols());
+  for (int c=0; c<E_.outerSize(); ++c) {
+    for (SpMat::InnerIterator it(E_, c); it; ++it) {
+      const size_t p = it.row() % dn;
+      const size_t q = it.row() / dn;
+      for (int l=0; l<K.cols(); ++l) {
+        coeffs.emplace_back(p + l*dn, c, it.value() * K(q, l));
+      }
+    }
+  }
+
+  B_.resize(dn*K.cols(), k);
+  B_.setFromTriplets(coeffs.begin(), coeffs.end());
+  Bt_ = B_.transpose();
+
+  // n.b., rows are redundant: K'GK is symmetric and, in 2D, G commutes with
+  // the rotation that maps the kernel onto itself.
+  BBs_.setShift(shift);
+  BBs_.compute((B_ * Bt_).pruned());
+
+  //
+  // Trace functional, Tr[\bar{A}] = <G, QQ'>, restricted to the subspace
+  //
+
+  const Eigen::MatrixXd M = Q_ * Q_.transpose();
+  Eigen::VectorXd g = Et_ * Eigen::Map<const Eigen::VectorXd>(M.data(),
+                                                                M.size());
+  Eigen::VectorXd r;
+  projectKernel(g, r);
+  trNorm_ = g.norm();
+  gtr_ = g / trNorm_;
+}
+
+// ----------------------------------------------------------------------------
+
+size_t NullSpace::storage() const
+{
+  return E_.nonZeros() + B_.nonZeros() + Q_.size();
+}
+
+// ----------------------------------------------------------------------------
+
+void NullSpace::project(const Eigen::VectorXd& x, Eigen::VectorXd& Px,
+                        Scratch& scratch) const
+{
+  Eigen::Map<const Eigen::MatrixXd> X(x.data(), N_, N_);
+  Px.setZero(N_*N_);
+  Eigen::Map<Eigen::MatrixXd> P(Px.data(), N_, N_);
+
+  // X_11 = tI, X_12 = 0 (homogeneous)
+  const double t = X.topLeftCorner(dm_, dm_).trace() / dm_;
+  P.topLeftCorner(dm_, dm_).diagonal().setConstant(t);
+
+  // \bar{A} through the coordinates of G = Q \bar{A} Q' (only its symmetric
+  // part has any, since the columns of E are symmetric patterns)
+  Eigen::MatrixXd& M = scratch.M;
+  Eigen::MatrixXd& T = scratch.T;
+  Eigen::VectorXd& g = scratch.g;
+  T.noalias() = Q_ * X.bottomRightCorner(dm_, dm_);
+  M.noalias() = T * Q_.transpose();
+  g.noalias() = Et_ * Eigen::Map<const Eigen::VectorXd>(M.data(), M.size());
+  projectGains(g, scratch);
+
+  Eigen::Map<Eigen::VectorXd>(M.data(), M.size()).noalias() = E_ * g;
+  T.noalias() = M * Q_;
+  P.bottomRightCorner(dm_, dm_).noalias() = Q_.transpose() * T;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::VectorXd NullSpace::particular() const
+{
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(N_*N_);
+  Eigen::Map<Eigen::MatrixXd> X(x.data(), N_, N_);
+
+  // X_12 = X_21 = I
+  X.topRightCorner(dm_, dm_).setIdentity();
+  X.bottomLeftCorner(dm_, dm_).setIdentity();
+
+  // Tr[\bar{A}] = dm along the trace functional, which is orthogonal to the
+  // homogeneous subspace
+  const size_t dn = Q_.rows();
+  const Eigen::VectorXd G = E_ * particularGains();
+  Eigen::Map<const Eigen::MatrixXd> Gm(G.data(), dn, dn);
+  X.bottomRightCorner(dm_, dm_) = Q_.transpose() * Gm * Q_;
+
+  return x;
+}
+
+// ----------------------------------------------------------------------------
+
+void NullSpace::projectGains(Eigen::VectorXd& g, Scratch& scratch) const
+{
+  projectKernel(g, scratch.r);
+  g -= gtr_.dot(g) * gtr_; // Tr[\bar{A}] = 0
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::VectorXd NullSpace::particularGains() const
+{
+  return (dm_ / trNorm_) * gtr_;
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+void NullSpace::projectKernel(Eigen::VectorXd& g, Eigen::VectorXd& r) const
+{
+  r.noalias() = B_ * g;
+  r = BBs_.solve(r);
+  g.noalias() -= Bt_ * r;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
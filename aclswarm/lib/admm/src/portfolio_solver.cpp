@@ -0,0 +1,211 @@
+/**
+ * @file portfolio_solver.cpp
+ * @brief Gain design racing several solver configurations on worker threads
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "admm/portfolio_solver.h"
+
+namespace acl {
+namespace aclswarm {
+namespace admm {
+
+PortfolioSolver::PortfolioSolver(const std::vector<Params>& configurations,
+                                  const Acceptance& acceptance)
+: acceptance_(acceptance), cancel_(false),
+  cacheSize_((configurations.empty()) ? 0 : configurations[0].cacheSize),
+  cache_(cacheSize_,
+          (configurations.empty()) ? 0 : configurations[0].cacheQuantum,
+          (configurations.empty()) ? 0 : configurations[0].thrPlanar)
+{
+  const std::vector<Params> configs = (configurations.empty())
+                                          ? PortfolioSolver::configurations()
+                                          : configurations;
+
+  solvers_.reserve(configs.size());
+  for (const auto& params : configs) {
+    Params p = params;
+    p.cacheSize = 0; // only the winner's gains are worth remembering
+    p.parallel = false; // the members already keep the cores busy
+    solvers_.emplace_back(new Solver(p));
+    solvers_.back()->setCancelFlag(&cancel_);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+PortfolioSolver::PortfolioSolver(const std::vector<Params>& configurations)
+: PortfolioSolver(configurations, Acceptance())
+{}
+
+// ----------------------------------------------------------------------------
+
+std::vector<Params> PortfolioSolver::configurations(const Params& params)
+{
+  // n.b., a larger mu weighs the linear constraints more and converges in
+  // far fewer iterations on some formations, but stalls on others
+  std::vector<Params> configs;
+  for (const double mu : {params.mu, 10 * params.mu}) {
+    for (const double alpha : {1.0, 1.6}) {
+      Params p = params;
+      p.mu = mu;
+      p.alpha = alpha;
+      p.residualStop = true;
+      configs.push_back(p);
+    }
+  }
+  return configs;
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd PortfolioSolver::solve(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality)
+{
+  quality = Quality();
+
+  BlockGainMat cached;
+  if (cacheSize_ > 0 && cache_.find(pts, adj, cached)) {
+    quality.cacheHit = true;
+    return cached.toDense();
+  }
+
+  std::vector<Eigen::MatrixXd> results(solvers_.size());
+  race(pts, adj, deadline, quality,
+    [&](size_t i, const Solver::Problem& problem, double budget,
+        Quality& q) {
+      results[i] = solvers_[i]->solve(problem, budget, q);
+    });
+  Eigen::MatrixXd gains = std::move(results[winner_]);
+
+  // n.b., gains cut short by a deadline are not worth remembering
+  if (cacheSize_ > 0 && quality.converged) {
+    cache_.insert(pts, adj, BlockGainMat::fromDense(gains, adj));
+  }
+
+  return gains;
+}
+
+// ----------------------------------------------------------------------------
+
+BlockGainMat PortfolioSolver::solveBlocks(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality)
+{
+  quality = Quality();
+
+  BlockGainMat gains;
+  if (cacheSize_ > 0 && cache_.find(pts, adj, gains)) {
+    quality.cacheHit = true;
+    return gains;
+  }
+
+  std::vector<BlockGainMat> results(solvers_.size());
+  race(pts, adj, deadline, quality,
+    [&](size_t i, const Solver::Problem& problem, double budget,
+        Quality& q) {
+      results[i] = solvers_[i]->solveBlocks(problem, adj, budget, q);
+    });
+  gains = std::move(results[winner_]);
+
+  // n.b., gains cut short by a deadline are not worth remembering
+  if (cacheSize_ > 0 && quality.converged) {
+    cache_.insert(pts, adj, gains);
+  }
+
+  return gains;
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+void PortfolioSolver::race(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality, const MemberSolve& solve)
+{
+  // The members only differ in their iterations, so the subproblems are
+  // parsed, equilibrated and factorized once, within the budget
+  const auto tstart = std::chrono::steady_clock::now();
+  Solver::Problem problem;
+  solvers_[0]->setup(pts, adj, problem);
+  double budget = 0;
+  if (deadline > 0) {
+    budget = deadline - std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - tstart).count();
+    budget = std::max(budget, std::numeric_limits<double>::min());
+  }
+
+  std::vector<Quality> qualities(solvers_.size());
+  std::exception_ptr error;
+  std::mutex mtx;
+  bool won = false;
+
+  // the first member with acceptable gains cancels the others
+  cancel_ = false;
+  auto work = [&](size_t i) {
+    try {
+      solve(i, problem, budget, qualities[i]);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!error) error = std::current_exception();
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (!won && accepted(qualities[i])) {
+      won = true;
+      winner_ = i;
+      cancel_ = true;
+    }
+  };
+
+  // n.b., cancelled members still finish their current iteration before they
+  // can be joined
+  std::vector<std::thread> workers;
+  workers.reserve(solvers_.size());
+  for (size_t i=1; i<solvers_.size(); ++i) workers.emplace_back(work, i);
+  work(0);
+  for (auto& w : workers) w.join();
+
+  if (!won) {
+    if (error) std::rethrow_exception(error);
+
+    // settle for the gains that come closest to stabilizing the formation
+    winner_ = 0;
+    for (size_t i=1; i<solvers_.size(); ++i) {
+      if (qualities[i].eigMargin > qualities[winner_].eigMargin) winner_ = i;
+    }
+  }
+
+  quality = qualities[winner_];
+}
+
+// ----------------------------------------------------------------------------
+
+bool PortfolioSolver::accepted(const Quality& quality) const
+{
+  if (quality.cacheHit) return true;
+  if (acceptance_.converged && !quality.converged) return false;
+  return quality.trErr <= acceptance_.maxTrErr
+          && quality.primalRes <= acceptance_.maxPrimalRes
+          && quality.dualRes <= acceptance_.maxDualRes
+          && quality.eigMargin >= acceptance_.minEigMargin;
+}
+
+} // ns admm
+} // ns aclswarm
+} // ns acl
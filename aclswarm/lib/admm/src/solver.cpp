@@ -5,21 +5,39 @@
  * @date 25 July 2020
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <future>
 #include <iostream>
+#include <limits>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <Eigen/Eigenvalues>
 #include <Eigen/SVD>
 #include <Eigen/SparseCholesky>
 
 #include "admm/solver.h"
+#include "admm/anderson.h"
+#include "admm/lanczos.h"
+#include "admm/low_rank.h"
 
 namespace acl {
 namespace aclswarm {
 namespace admm {
 
 Solver::Solver(const Params& params)
-: params_(params)
+: params_(params),
+  cache_(params.cacheSize, params.cacheQuantum, params.thrPlanar)
 {
+  // the matrix-free and null-space constraint operators work on vec(X)
+  if (params_.matrixFree || params_.nullSpace) {
+    params_.formulation = Formulation::Vec;
+  }
 
 }
 
@@ -29,62 +47,307 @@ Eigen::MatrixXd Solver::solve(
                         const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
                         const Eigen::MatrixXd& adj)
 {
+  Quality quality;
+  return solve(pts, adj, 0, quality);
+}
 
-  //
-  // Solve 2D gain design subproblem
-  //
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Solver::solve(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality)
+{
+  quality = Quality();
 
-  const auto A2d = solve2d(pts.topRows(2), adj);
+  BlockGainMat gains;
+  if (params_.cacheSize > 0 && cache_.find(pts, adj, gains)) {
+    if (params_.verbose) std::cout << "Gain cache hit" << std::endl;
+    quality.cacheHit = true;
+    return gains.toDense();
+  }
+
+  Eigen::MatrixXd A2d, A1d;
+  solveFormation(pts, adj, deadline, quality, A2d, A1d);
+
+  // n.b., gains cut short by a deadline are not worth remembering
+  if (params_.cacheSize > 0 && quality.converged) {
+    cache_.insert(pts, adj, interleaveBlocks(A2d, A1d, adj));
+  }
+
+  return interleave(A2d, A1d);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::setup(const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                    const Eigen::MatrixXd& adj, Problem& problem)
+{
+  if (params_.parallel) {
+    std::future<void> f1d = std::async(std::launch::async,
+          [&]() { setup1d(pts.bottomRows(1), adj, problem.sp1d); });
+    setup2d(pts.topRows(2), adj, problem.sp2d);
+    f1d.get();
+  } else {
+    setup2d(pts.topRows(2), adj, problem.sp2d);
+    setup1d(pts.bottomRows(1), adj, problem.sp1d);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Solver::solve(const Problem& problem, double deadline,
+                              Quality& quality)
+{
+  quality = Quality();
+
+  Eigen::MatrixXd A2d, A1d;
+  solveSubproblems(deadline, quality,
+    [&](Clock::time_point deadline1d) {
+      return design(problem.sp1d, ws1d_, work1d_, stats1d_, deadline1d);
+    },
+    [&](Clock::time_point deadline2d) {
+      return design(problem.sp2d, ws2d_, work2d_, stats2d_, deadline2d);
+    }, A2d, A1d);
+
+  return interleave(A2d, A1d);
+}
+
+// ----------------------------------------------------------------------------
+
+BlockGainMat Solver::solveBlocks(const Problem& problem,
+                                 const Eigen::MatrixXd& adj, double deadline,
+                                 Quality& quality)
+{
+  quality = Quality();
+
+  Eigen::MatrixXd A2d, A1d;
+  solveSubproblems(deadline, quality,
+    [&](Clock::time_point deadline1d) {
+      return design(problem.sp1d, ws1d_, work1d_, stats1d_, deadline1d);
+    },
+    [&](Clock::time_point deadline2d) {
+      return design(problem.sp2d, ws2d_, work2d_, stats2d_, deadline2d);
+    }, A2d, A1d);
+
+  return interleaveBlocks(A2d, A1d, adj);
+}
+
+// ----------------------------------------------------------------------------
+
+BlockGainMat Solver::solveBlocks(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj)
+{
+  Quality quality;
+  return solveBlocks(pts, adj, 0, quality);
+}
+
+// ----------------------------------------------------------------------------
+
+BlockGainMat Solver::solveBlocks(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality)
+{
+  quality = Quality();
+
+  BlockGainMat gains;
+  if (params_.cacheSize > 0 && cache_.find(pts, adj, gains)) {
+    if (params_.verbose) std::cout << "Gain cache hit" << std::endl;
+    quality.cacheHit = true;
+    return gains;
+  }
+
+  Eigen::MatrixXd A2d, A1d;
+  solveFormation(pts, adj, deadline, quality, A2d, A1d);
+  gains = interleaveBlocks(A2d, A1d, adj);
+
+  // n.b., gains cut short by a deadline are not worth remembering
+  if (params_.cacheSize > 0 && quality.converged) {
+    cache_.insert(pts, adj, gains);
+  }
+
+  return gains;
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::resetWarmStart()
+{
+  ws1d_ = WarmStart();
+  ws2d_ = WarmStart();
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+void Solver::solveFormation(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality,
+                        Eigen::MatrixXd& A2d, Eigen::MatrixXd& A1d)
+{
+  // n.b., each subproblem is set up within its share of the budget
+  Problem problem;
+  solveSubproblems(deadline, quality,
+    [&](Clock::time_point deadline1d) {
+      setup1d(pts.bottomRows(1), adj, problem.sp1d);
+      return design(problem.sp1d, ws1d_, work1d_, stats1d_, deadline1d);
+    },
+    [&](Clock::time_point deadline2d) {
+      setup2d(pts.topRows(2), adj, problem.sp2d);
+      return design(problem.sp2d, ws2d_, work2d_, stats2d_, deadline2d);
+    }, A2d, A1d);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::solveSubproblems(double deadline, Quality& quality,
+                              const Subsolve& solve1d,
+                              const Subsolve& solve2d,
+                              Eigen::MatrixXd& A2d, Eigen::MatrixXd& A1d)
+{
+  // Absolute deadline of each subproblem. When solved one after the other,
+  // the 1D subproblem keeps its share of the budget: with half the
+  // dimension of the 2D one, it costs roughly 1/8 as much.
+  Clock::time_point deadline1d = Clock::time_point::max();
+  Clock::time_point deadline2d = Clock::time_point::max();
+  if (deadline > 0) {
+    const auto tstart = Clock::now();
+    const auto budget = std::chrono::duration_cast<Clock::duration>(
+                          std::chrono::duration<double, std::milli>(deadline));
+    deadline1d = tstart + budget;
+    deadline2d = (params_.parallel) ? deadline1d : tstart + budget * 8 / 9;
+  }
 
   //
-  // Solve 1D gain design subproblem
+  // Solve 2D and 1D gain design subproblems
   //
 
-  const auto A1d = solve1d(pts.bottomRows(1), adj);
+  // n.b., the two subproblems are independent and each only touches its own
+  // warm start and factorization cache, so they can safely run concurrently.
+  if (params_.parallel) {
+    std::future<Eigen::MatrixXd> f1d = std::async(std::launch::async,
+                                                  solve1d, deadline1d);
+    A2d = solve2d(deadline2d);
+    A1d = f1d.get();
+  } else {
+    A2d = solve2d(deadline2d);
+    A1d = solve1d(deadline1d);
+  }
+
+  quality.converged = !stats1d_.deadline && !stats2d_.deadline
+                      && !stats1d_.cancelled && !stats2d_.cancelled;
+  quality.trErr = std::max(stats1d_.trErr, stats2d_.trErr);
+  quality.primalRes = std::max(stats1d_.primalRes, stats2d_.primalRes);
+  quality.dualRes = std::max(stats1d_.dualRes, stats2d_.dualRes);
+  quality.eigMargin = std::min(stats1d_.eigMargin, stats2d_.eigMargin);
+}
 
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Solver::interleave(const Eigen::MatrixXd& A2d,
+                                   const Eigen::MatrixXd& A1d) const
+{
   //
   // Combine for 3D gain design problem
   //
 
-  const size_t n = pts.cols();
+  const size_t n = A1d.rows();
   Eigen::MatrixXd A = Eigen::MatrixXd::Zero(3*n,3*n);
-  for (size_t i=0; i<A.rows(); ++i) {
-    for (size_t j=0; j<A.cols(); ++j) {
 
-      // which 3x3 A_ij sub-block are we in?
-      const size_t blki = i / 3;
-      const size_t blkj = j / 3;
+  // fills rows [r0, r1) of A. Each worker writes disjoint rows.
+  auto fillRows = [&](size_t r0, size_t r1) {
+    for (size_t i=r0; i<r1; ++i) {
+      for (int j=0; j<A.cols(); ++j) {
 
-      // map index into 2d sub-block
-      const size_t i2d = i - blki;
-      const size_t j2d = j - blkj;
+        // which 3x3 A_ij sub-block are we in?
+        const size_t blki = i / 3;
+        const size_t blkj = j / 3;
 
-      // map index into 1d sub-block
-      const size_t i1d = blki;
-      const size_t j1d = blkj;
+        // map index into 2d sub-block
+        const size_t i2d = i - blki;
+        const size_t j2d = j - blkj;
 
-      // determine if we are indexing the 3rd row/col in A_ij
-      bool row3 = ((i+1) % 3) == 0;
-      bool col3 = ((j+1) % 3) == 0;
+        // map index into 1d sub-block
+        const size_t i1d = blki;
+        const size_t j1d = blkj;
 
-      if (!row3 && !col3) {
-        A(i,j) = A2d(i2d,j2d);
-      } else if (row3 && col3) {
-        A(i,j) = A1d(i1d,j1d);
+        // determine if we are indexing the 3rd row/col in A_ij
+        bool row3 = ((i+1) % 3) == 0;
+        bool col3 = ((j+1) % 3) == 0;
+
+        if (!row3 && !col3) {
+          A(i,j) = A2d(i2d,j2d);
+        } else if (row3 && col3) {
+          A(i,j) = A1d(i1d,j1d);
+        }
       }
     }
+  };
+
+  const size_t nthreads = (params_.parallel) ? numThreads(n) : 1;
+  if (nthreads > 1) {
+    // split by agent so that each worker owns whole 3-row block rows
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads - 1);
+    for (size_t t=1; t<nthreads; ++t) {
+      workers.emplace_back(fillRows, 3*(t*n/nthreads), 3*((t+1)*n/nthreads));
+    }
+    fillRows(0, 3*(n/nthreads));
+    for (auto& w : workers) w.join();
+  } else {
+    fillRows(0, A.rows());
   }
 
   return A;
 }
 
 // ----------------------------------------------------------------------------
-// Private Methods
+
+BlockGainMat Solver::interleaveBlocks(const Eigen::MatrixXd& A2d,
+                                      const Eigen::MatrixXd& A1d,
+                                      const Eigen::MatrixXd& adj) const
+{
+  // A_ij = [2D block of i and j, 0; 0, 1D entry of i and j]
+  auto fill = [&](size_t i, size_t j, Eigen::Matrix3d& Aij) {
+    Aij.topLeftCorner<2,2>() = A2d.block<2,2>(2*i, 2*j);
+    Aij(2,2) = A1d(i,j);
+  };
+
+  // n.b., in storage order, i.e., the diagonal then edges i < j by row
+  const size_t n = A1d.rows();
+  BlockGainMat G(adj);
+  size_t k = n;
+  for (size_t i=0; i<n; ++i) {
+    fill(i, i, G.stored(i));
+    for (size_t j=i+1; j<n; ++j) {
+      if (adj(i,j) != 0) fill(i, j, G.stored(k++));
+    }
+  }
+
+  return G;
+}
+
 // ----------------------------------------------------------------------------
 
-Eigen::MatrixXd Solver::solve1d(
-                        const Eigen::Matrix<double, 1, Eigen::Dynamic>& pts,
-                        const Eigen::MatrixXd& adj)
+size_t Solver::numThreads(size_t n) const
+{
+  size_t nthreads = params_.numThreads;
+  if (nthreads == 0) nthreads = std::thread::hardware_concurrency();
+
+  // spawning threads is not worth it for a handful of rows each
+  static constexpr size_t minAgentsPerThread = 8;
+  nthreads = std::min(nthreads, n / minAgentsPerThread);
+  return std::max<size_t>(nthreads, 1);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::setup1d(const Eigen::Matrix<double, 1, Eigen::Dynamic>& pts,
+                      const Eigen::MatrixXd& adj, Subproblem& sp)
 {
 
   //
@@ -108,9 +371,10 @@ Eigen::MatrixXd Solver::solve1d(
   size_t dimKer;
   Eigen::MatrixXd N;
   if (xyflat) {
+    // n.b., qz is (nearly) constant, possibly zero: only consensus remains
     dimKer = 1;
     N = Eigen::MatrixXd(pts.size(), dimKer);
-    N << qz;
+    N << ez;
   } else {
     dimKer = 2;
     N = Eigen::MatrixXd(pts.size(), dimKer);
@@ -121,36 +385,23 @@ Eigen::MatrixXd Solver::solve1d(
   // find the orthogonal complement of the kernel
   // recall: N = [U1 U2][S 0; 0 0][V1h; V2h]. We want U2.
   Eigen::JacobiSVD<Eigen::MatrixXd> svd(N, Eigen::ComputeFullU);
-  Eigen::MatrixXd Q = svd.matrixU().rightCols(svd.matrixU().cols() - dimKer);
+  sp.Q = svd.matrixU().rightCols(svd.matrixU().cols() - dimKer);
 
   //
   // Build the gain design optimization problem
   //
 
-  SpMat C, A, b, X;
-  parse(d, m, n, adj, Q, C, A, b, X);
-
-  //
-  // Solve SDP using ADMM on sparse matrices
-  //
-
-  admm(C, A, b, X);
-
-  //
-  // Recover gain matrix
-  //
-
-  Eigen::MatrixXd Aopt = - Q * X.bottomRightCorner(d*m, d*m) * Q.transpose();
-  Aopt = (params_.thrSparseZero < Aopt.array().abs()).select(Aopt, 0.0);
-
-  return Aopt;
+  sp.d = d;
+  sp.m = m;
+  sp.n = n;
+  sp.adj = adj;
+  setup(sp, fc1d_);
 }
 
 // ----------------------------------------------------------------------------
 
-Eigen::MatrixXd Solver::solve2d(
-                        const Eigen::Matrix<double, 2, Eigen::Dynamic>& pts,
-                        const Eigen::MatrixXd& adj)
+void Solver::setup2d(const Eigen::Matrix<double, 2, Eigen::Dynamic>& pts,
+                      const Eigen::MatrixXd& adj, Subproblem& sp)
 {
 
   //
@@ -185,26 +436,150 @@ Eigen::MatrixXd Solver::solve2d(
   // find the orthogonal complement of the kernel
   // recall: N = [U1 U2][S 0; 0 0][V1h; V2h]. We want U2.
   Eigen::JacobiSVD<Eigen::MatrixXd> svd(N, Eigen::ComputeFullU);
-  Eigen::MatrixXd Q = svd.matrixU().rightCols(svd.matrixU().cols() - dimKer);
+  sp.Q = svd.matrixU().rightCols(svd.matrixU().cols() - dimKer);
 
   //
   // Build the gain design optimization problem
   //
 
-  SpMat C, A, b, X;
-  parse(d, m, n, adj, Q, C, A, b, X);
+  sp.d = d;
+  sp.m = m;
+  sp.n = n;
+  sp.adj = adj;
+  setup(sp, fc2d_);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::setup(Subproblem& sp, FactorCache& fc)
+{
+  // only pay for timing if someone is listening
+  Telemetry * tel = (params_.telemetry) ? &sp.tel : nullptr;
+  const auto tstart = std::chrono::steady_clock::now();
+
+  const size_t d = sp.d, m = sp.m, n = sp.n;
+  sp.f = formulation(d);
+
+  // Complete graph: only the trace and PSD constraints on \bar{A} remain,
+  // and their optimum is known (see design)
+  const size_t nr0 = ((sp.adj.array()==0).count() - n)/2; // number of zeros
+  sp.closedForm = params_.closedForm && nr0 == 0;
+  if (sp.closedForm) return;
+
+  auto t0 = std::chrono::steady_clock::now();
+  if (params_.lowRank) {
+    sp.ns.reset(new NullSpace(d, sp.adj, sp.Q, params_.shiftAAs));
+    if (tel) tel->tFactorize = telemetry::elapsedMs(t0);
+    if (tel) tel->rowsA = sp.ns->coordinates();
+    if (tel) tel->nnzA = sp.ns->storage();
+    if (tel) tel->tTotal = telemetry::elapsedMs(tstart);
+    return;
+  }
 
   //
-  // Solve SDP using ADMM on sparse matrices
+  // Build the gain design optimization problem
   //
 
-  admm(C, A, b, X);
+  // when matrix-free, graph constraints are not written into A
+  std::vector<Constraints::GraphRow> * g = (params_.matrixFree)
+                                                ? &sp.graph : nullptr;
+  if (params_.nullSpace) {
+    initialize(d*m, sp.C, sp.X0); // the equality rows are parametrized instead
+  } else if (!params_.specializeDim) {
+    parse<Eigen::Dynamic>(d, m, n, sp.adj, sp.Q, sp.C, sp.A, sp.b, sp.X0, g);
+  } else if (d == 1) {
+    parse<1>(d, m, n, sp.adj, sp.Q, sp.C, sp.A, sp.b, sp.X0, g);
+  } else {
+    parse<2>(d, m, n, sp.adj, sp.Q, sp.C, sp.A, sp.b, sp.X0, g);
+  }
+
+  // n.b., the matrix-free and null-space operators are not stored as rows
+  sp.scaled = params_.equilibrate && sp.f == Formulation::Hermitian
+                && !params_.matrixFree && !params_.nullSpace;
+  if (sp.scaled) equilibrate(sp.C, sp.A, sp.b, sp.scaling);
+  if (tel) tel->tParse = telemetry::elapsedMs(tstart);
+
+  //
+  // Constraint operator of ADMM
+  //
+
+  t0 = std::chrono::steady_clock::now();
+  if (params_.nullSpace) {
+    sp.ns.reset(new NullSpace(d, sp.adj, sp.Q, params_.shiftAAs));
+    sp.op.reset(new Constraints(*sp.ns));
+    sp.b = sp.ns->particular().sparseView();
+  } else if (params_.matrixFree) {
+    sp.b.conservativeResize(sp.A.rows() + sp.graph.size(), 1); // b = 0
+    sp.op.reset(new Constraints(sp.A, sp.graph, sp.Q, params_.cgTol,
+                                params_.cgMaxItr));
+  } else {
+    factorize(d, n, sp.adj, sp.A, fc);
+    sp.op.reset(new Constraints(sp.A, fc.chol));
+  }
+  if (tel) tel->tFactorize = telemetry::elapsedMs(t0);
+  if (tel) tel->nnzA = sp.op->storage();
+  if (tel) tel->rowsA = sp.b.rows();
+  if (tel) tel->tTotal = telemetry::elapsedMs(tstart);
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd Solver::design(const Subproblem& sp, WarmStart& ws,
+                                Workspace& work, Stats& stats,
+                                Clock::time_point deadline)
+{
+  // only pay for timing if someone is listening, n.b., on top of the setup
+  Telemetry telemetry = sp.tel;
+  Telemetry * tel = (params_.telemetry) ? &telemetry : nullptr;
+  const auto tstart = std::chrono::steady_clock::now();
+
+  const size_t dm = sp.d * sp.m;
+  Iterate X;
+  if (sp.closedForm) {
+    // With X_11 = tI and X_12 = I, the Schur complement gives \bar{A} >= I/t,
+    // so Tr[\bar{A}] = dm forces t >= 1, and t = 1 with \bar{A} = I is
+    // optimal.
+    SpMat X0(2*dm, 2*dm); // [I I; I I]
+    std::vector<Eigen::Triplet<double>> coeffs;
+    coeffs.reserve(4*dm);
+    for (size_t i=0; i<dm; ++i) {
+      coeffs.emplace_back(i, i, 1);
+      coeffs.emplace_back(dm+i, i, 1);
+      coeffs.emplace_back(i, dm+i, 1);
+      coeffs.emplace_back(dm+i, dm+i, 1);
+    }
+    X0.setFromTriplets(coeffs.begin(), coeffs.end());
+    X = Iterate(X0);
+
+    stats = Stats();
+    stats.eigMargin = 1; // \bar{A} = I
+  } else if (params_.lowRank) {
+    X = designLowRank(sp, stats, deadline, tel);
+  } else {
+    // seed ADMM with the solution of the last (similar) formation
+    X = Iterate(sp.X0);
+    Iterate S(SpMat(sp.X0.rows(), sp.X0.cols()));
+    if (params_.warmStart) applyWarmStart(ws, sp.Q, X, S);
+
+    admm(sp.C, *sp.op, sp.b, sp.f, work, X, S, stats, deadline, tel,
+          (sp.scaled) ? &sp.scaling : nullptr);
+
+    if (params_.warmStart) storeWarmStart(sp.Q, X, S, ws);
+  }
+
+  if (tel) {
+    tel->d = sp.d;
+    tel->n = sp.n;
+    tel->dimX = X.rows();
+    tel->tTotal += telemetry::elapsedMs(tstart);
+    params_.telemetry(*tel);
+  }
 
   //
   // Recover gain matrix
   //
 
-  Eigen::MatrixXd Aopt = - Q * X.bottomRightCorner(d*m, d*m) * Q.transpose();
+  Eigen::MatrixXd Aopt = - sp.Q * X.bottomRightCorner(dm) * sp.Q.transpose();
   Aopt = (params_.thrSparseZero < Aopt.array().abs()).select(Aopt, 0.0);
 
   return Aopt;
@@ -212,7 +587,116 @@ Eigen::MatrixXd Solver::solve2d(
 
 // ----------------------------------------------------------------------------
 
-inline size_t Solver::vecsel(size_t rows, size_t cols, size_t i, size_t j)
+Iterate Solver::designLowRank(const Subproblem& sp, Stats& stats,
+                              Clock::time_point deadline, Telemetry* tel)
+{
+  stats = Stats();
+  const size_t d = sp.d;
+  const size_t dm = sp.Q.cols();
+  const NullSpace& ns = *sp.ns;
+
+  // Some optimal dual solution has a rank r with r(r+1)/2 at most the number
+  // of constraints (Pataki), and factors of such a rank generically have no
+  // spurious local minima. In practice, far less than dm.
+  size_t rank = params_.lowRankDim;
+  if (rank == 0) {
+    const double p = ns.coordinates();
+    rank = static_cast<size_t>(std::ceil((std::sqrt(8*p + 1) - 1) / 2));
+  }
+
+  LowRank lr(ns, sp.Q, rank, params_.lowRankSigma);
+
+  Clock::time_point t0;
+  const double tol = params_.lowRankTol;
+  static constexpr size_t maxEscapes = 5;
+  size_t escapes = 0;
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es;
+  for (size_t i=0; i<params_.lowRankMaxItr; ++i) {
+    IterationTelemetry it;
+    if (tel) t0 = std::chrono::steady_clock::now();
+
+    const double gnorm = lr.step();
+    stats.iterations++;
+
+    if (tel) it.tUpdate = telemetry::elapsedMs(t0);
+    if (tel) t0 = std::chrono::steady_clock::now();
+
+    // \bar{A} is feasible, only the dual factor is not
+    stats.dualRes = lr.infeasibility();
+
+    // update the multiplier once V is about as stationary as it is feasible
+    bool stop = false;
+    if (gnorm < std::max(tol, 0.1 * stats.dualRes)) {
+      stop = gnorm < tol && stats.dualRes < tol;
+      if (!stop) lr.updateMultiplier();
+    }
+
+    // converged, but to a saddle point if \bar{A} has eigenvalues below the
+    // objective: their eigenvectors are missing from V. n.b., the only
+    // eigendecompositions of the engine, i.e., once per convergence.
+    if (stop && escapes < maxEscapes) {
+      es.compute(lr.abar());
+      const double gap = 10 * tol * (1 + std::abs(lr.objective()));
+      const Eigen::VectorXd& ev = es.eigenvalues();
+      const Eigen::Index kmax = std::min<Eigen::Index>(ev.size(), 2*d);
+      Eigen::Index k = 0;
+      while (k < kmax && ev(k) < lr.objective() - gap) ++k;
+      if (k > 0) {
+        lr.escape(es.eigenvectors().leftCols(k), 0.1);
+        stop = false;
+        escapes++;
+      }
+    }
+
+    if (tel) {
+      it.tStop = telemetry::elapsedMs(t0);
+      it.dualRes = stats.dualRes;
+      it.mu = params_.lowRankSigma;
+      tel->iterations.push_back(it);
+    }
+
+    if (stop) break;
+
+    // out of time: \bar{A} is feasible, just not optimal
+    if (Clock::now() >= deadline) {
+      stats.deadline = true;
+      break;
+    }
+
+    if (cancel_ && cancel_->load(std::memory_order_relaxed)) {
+      stats.cancelled = true;
+      break;
+    }
+  }
+
+  //
+  // X = [tI I; I \bar{A}] is PSD iff \bar{A} >= I/t
+  //
+
+  const auto tproj = std::chrono::steady_clock::now();
+
+  const Eigen::MatrixXd Abar = lr.abar();
+  es.compute(Abar, Eigen::EigenvaluesOnly);
+  stats.trErr = std::abs(Abar.trace() - dm) / dm;
+  stats.eigMargin = es.eigenvalues()(0);
+
+  // n.b., no t makes X PSD if \bar{A} is not positive definite
+  const double t = (stats.eigMargin > 0) ? 1 / stats.eigMargin : 0;
+  Eigen::MatrixXd X(2*dm, 2*dm);
+  X << t * Eigen::MatrixXd::Identity(dm, dm), Eigen::MatrixXd::Identity(dm, dm),
+       Eigen::MatrixXd::Identity(dm, dm), Abar;
+
+  Iterate Xi(SpMat(2*dm, 2*dm));
+  Xi.assign(X, params_.denseFill);
+
+  if (tel) tel->tProject = telemetry::elapsedMs(tproj);
+
+  return Xi;
+}
+
+// ----------------------------------------------------------------------------
+
+inline size_t Solver::vecsel(size_t rows, size_t /*cols*/, size_t i, size_t j)
 {
   return j*rows + i;
 }
@@ -226,132 +710,719 @@ inline size_t Solver::blksel(size_t dim, size_t blkidx, size_t subidx)
 
 // ----------------------------------------------------------------------------
 
-inline void Solver::vectorize(const SpMat& X, SpMat& x)
+inline size_t Solver::svecsel(size_t i, size_t j)
 {
-  x.resize(X.size(), 1);
-  x.reserve(X.nonZeros());
-  x.startVec(0);
-  for (size_t j=0; j<X.cols(); ++j) {
-    for (SpMat::InnerIterator it(X, j); it; ++it) {
-      x.insertBack(j*X.rows() + it.row(), 0) = it.value();
+  // upper triangle (i <= j), column by column
+  if (i > j) std::swap(i, j);
+  return j*(j+1)/2 + i;
+}
+
+// ----------------------------------------------------------------------------
+
+inline size_t Solver::hermsel(size_t k, size_t l, size_t part)
+{
+  // upper triangle (k <= l) of a Hermitian matrix, column by column, with
+  // (Re, Im) of each off-diagonal entry and only Re on the diagonal.
+  if (k > l) std::swap(k, l);
+  return l*l + 2*k + part;
+}
+
+// ----------------------------------------------------------------------------
+
+Formulation Solver::formulation(size_t d) const
+{
+  // there is no complex structure to exploit in 1D
+  if (d == 1 && params_.formulation == Formulation::Hermitian) {
+    return Formulation::SVec;
+  }
+  return params_.formulation;
+}
+
+// ----------------------------------------------------------------------------
+
+inline void Solver::vectorize(const Eigen::MatrixXd& X, Eigen::VectorXd& x,
+                              Formulation f)
+{
+  if (f == Formulation::Hermitian) {
+    // n.b., X is the real representation of a Hermitian Z. Entries are
+    // scaled so that x'y == <X, Y>, i.e., sqrt(2) on the diagonal and 2 off.
+    const size_t M = X.rows() / 2;
+    for (size_t l=0; l<M; ++l) {
+      for (size_t k=0; k<l; ++k) {
+        x(hermsel(k, l, 0)) = 2 * X(2*k,2*l);
+        x(hermsel(k, l, 1)) = 2 * X(2*k+1,2*l);
+      }
+      x(hermsel(l, l, 0)) = std::sqrt(2.0) * X(2*l,2*l);
     }
+    return;
   }
+
+  if (f == Formulation::SVec) {
+    // n.b., X is symmetric. Off-diagonals are scaled so that
+    // svec(X)'svec(Y) == <X, Y>.
+    const size_t N = X.cols();
+    for (size_t j=0; j<N; ++j) {
+      for (size_t i=0; i<j; ++i) {
+        x(svecsel(i, j)) = std::sqrt(2.0) * X(i,j);
+      }
+      x(svecsel(j, j)) = X(j,j);
+    }
+    return;
+  }
+
+  x = Eigen::Map<const Eigen::VectorXd>(X.data(), X.size());
 }
 
 // ----------------------------------------------------------------------------
 
-inline void Solver::unvectorize(const SpMat& x, SpMat& X)
+inline void Solver::unvectorize(const Eigen::VectorXd& x, Eigen::MatrixXd& X,
+                                Formulation f)
 {
-  X.reserve(x.nonZeros());
-  int curj = -1;
+  if (f == Formulation::Hermitian) {
+    const size_t M = X.rows() / 2;
+    for (size_t l=0; l<M; ++l) {
+      for (size_t k=0; k<l; ++k) {
+        const double a = x(hermsel(k, l, 0)) / 2.0;
+        const double c = x(hermsel(k, l, 1)) / 2.0;
+        X(2*k,2*l) = X(2*k+1,2*l+1) = X(2*l,2*k) = X(2*l+1,2*k+1) = a;
+        X(2*k+1,2*l) = X(2*l,2*k+1) = c;
+        X(2*k,2*l+1) = X(2*l+1,2*k) = -c;
+      }
+      X(2*l,2*l) = X(2*l+1,2*l+1) = x(hermsel(l, l, 0)) / std::sqrt(2.0);
+      X(2*l,2*l+1) = X(2*l+1,2*l) = 0;
+    }
+    return;
+  }
+
+  if (f == Formulation::SVec) {
+    const size_t N = X.cols();
+    for (size_t j=0; j<N; ++j) {
+      for (size_t i=0; i<j; ++i) {
+        X(i,j) = X(j,i) = x(svecsel(i, j)) / std::sqrt(2.0);
+      }
+      X(j,j) = x(svecsel(j, j));
+    }
+    return;
+  }
+
+  X = Eigen::Map<const Eigen::MatrixXd>(x.data(), X.rows(), X.cols());
+}
 
-  for (SpMat::InnerIterator it(x, 0); it; ++it) {
+// ----------------------------------------------------------------------------
+
+void Solver::applyWarmStart(const WarmStart& ws, const Eigen::MatrixXd& Q,
+                            Iterate& X, Iterate& S)
+{
+  // only reuse the previous state if the problem size is unchanged
+  if (ws.Q.rows() != Q.rows() || ws.Q.cols() != Q.cols()) return;
+  if (ws.X.rows() != X.rows() || ws.S.rows() != S.rows()) return;
+
+  // X and S are expressed w.r.t the kernel complement of the last formation.
+  // Change basis into the current one, i.e., \bar{A} <-- R' \bar{A} R. For
+  // the X_11 and X_12 blocks this is exact when the kernels coincide.
+  const size_t dm = Q.cols();
+  const Eigen::MatrixXd R = ws.Q.transpose() * Q;
+  Eigen::MatrixXd T = Eigen::MatrixXd::Zero(2*dm, 2*dm);
+  T.topLeftCorner(dm, dm) = R;
+  T.bottomRightCorner(dm, dm) = R;
+
+  Eigen::MatrixXd Xws = ws.X.congruence(T);
+  Eigen::MatrixXd Sws = ws.S.congruence(T);
+  const double thr = params_.thrSparseZero;
+  Xws = (Xws.array().abs() > thr).select(Xws, 0.0);
+  Sws = (Sws.array().abs() > thr).select(Sws, 0.0);
+  X.assign(Xws, params_.denseFill);
+  S.assign(Sws, params_.denseFill);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::storeWarmStart(const Eigen::MatrixXd& Q, const Iterate& X,
+                            const Iterate& S, WarmStart& ws)
+{
+  ws.Q = Q;
+  ws.X = X;
+  ws.S = S;
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::initialize(size_t dm, SpMat& C, SpMat& X)
+{
+  C.resize(2*dm, 2*dm);
+  C.reserve(Eigen::VectorXi::Constant(2*dm,1)); // at most 1 nz per column
+  for (size_t i=0; i<dm; ++i) C.insert(i,i) = 1; // make [I 0; 0 0]
+
+  // initialize decision variable to something fairly close
+  X.resize(2*dm, 2*dm); // [I I; I I]
+  X.reserve(Eigen::VectorXi::Constant(2*dm,2)); // reserve 2 nz per column
+  for (size_t i=0; i<dm; ++i) {
+    X.insert(i,i) = 1;
+    X.insert(dm+i,i) = 1;
+  }
+  for (size_t i=dm; i<2*dm; ++i) {
+    X.insert(i,i) = 1;
+    X.insert(i-dm,i) = 1;
+  }
+}
+
+// ----------------------------------------------------------------------------
 
-    // select the correct destination row/col.
-    const size_t i = it.row() % X.rows();
-    const size_t j = it.row() / X.cols();
-    if (j != curj) {
-      X.startVec(j);
-      curj = j;
+void Solver::equilibrate(SpMat& C, SpMat& A, SpMat& b, Scaling& scale)
+{
+  const size_t N = C.rows();
+
+  // entry (i, j) of X that each column of A acts on, i.e., scaled by d_i d_j.
+  // n.b., D is constant on each (2k, 2k+1) pair, so \tilde{X} keeps the
+  // complex structure and Z_kl is scaled by d_2k d_2l
+  std::vector<std::pair<size_t, size_t>> ij(A.cols());
+  for (size_t l=0; l<N/2; ++l) {
+    for (size_t k=0; k<=l; ++k) {
+      ij[hermsel(k, l, 0)] = {2*k, 2*l};
+      if (k < l) ij[hermsel(k, l, 1)] = {2*k, 2*l};
+    }
+  }
+
+  //
+  // Ruiz: repeatedly divide each row and each index of X by the square root
+  // of its largest (scaled) coefficient, which drives them towards 1
+  //
+
+  // n.b., rows of roundoff-level coefficients (e.g., graph constraints
+  // that Q nearly annihilates) would be blown up to O(1), so they are kept
+  const double tiny = 1e-10 * Eigen::Map<const Eigen::VectorXd>(A.valuePtr(),
+                                          A.nonZeros()).cwiseAbs().maxCoeff();
+
+  Eigen::VectorXd& dX = scale.dX;
+  dX = Eigen::VectorXd::Ones(N);
+  Eigen::VectorXd dr = Eigen::VectorXd::Ones(A.rows());
+  Eigen::VectorXd rmax(A.rows()), xmax(N);
+  for (size_t k=0; k<params_.equilibrateItr; ++k) {
+    rmax.setZero();
+    xmax.setZero();
+    for (int c=0; c<A.outerSize(); ++c) {
+      const size_t i = ij[c].first, j = ij[c].second;
+      for (SpMat::InnerIterator it(A, c); it; ++it) {
+        const double v = std::abs(it.value()) * dr(it.row()) * dX(i) * dX(j);
+        rmax(it.row()) = std::max(rmax(it.row()), v);
+        xmax(i) = std::max(xmax(i), v);
+        xmax(j) = std::max(xmax(j), v);
+      }
+    }
+
+    for (size_t p=0; p<N; p+=2) {
+      xmax(p) = xmax(p+1) = std::max(xmax(p), xmax(p+1));
+    }
+
+    // n.b., a column is scaled by both of its indices, hence the 4th root
+    for (int r=0; r<A.rows(); ++r) {
+      if (rmax(r) > tiny) dr(r) /= std::sqrt(rmax(r));
+    }
+    for (size_t p=0; p<N; ++p) {
+      if (xmax(p) > 0) dX(p) /= std::sqrt(std::sqrt(xmax(p)));
     }
+  }
+
+  //
+  // Scale the problem: <C, X> = <DCD, \tilde{X}>, R A(D \tilde{X} D) = R b
+  //
+
+  for (int c=0; c<A.outerSize(); ++c) {
+    const double s = dX(ij[c].first) * dX(ij[c].second);
+    for (SpMat::InnerIterator it(A, c); it; ++it) {
+      it.valueRef() *= dr(it.row()) * s;
+    }
+  }
+  for (SpMat::InnerIterator it(b, 0); it; ++it) {
+    it.valueRef() *= dr(it.row());
+  }
+  C = dX.asDiagonal() * C * dX.asDiagonal();
+
+  scale.dXinv = dX.cwiseInverse();
+  scale.drinv = dr.cwiseInverse();
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::factorize(size_t d, size_t n, const Eigen::MatrixXd& adj,
+                        const SpMat& A, FactorCache& fc)
+{
+  const SpMat AAs = (A * A.adjoint()).pruned();
+
+  // The sparsity pattern of A*A' is determined by (d, n, adj). Only the
+  // values of the graph constraints change (they depend on Q). Even so,
+  // verify the pattern since the prune could drop coincidental zeros.
+  bool hit = params_.cacheFactorization && fc.d == d && fc.n == n
+              && fc.adj.rows() == adj.rows() && fc.adj.cols() == adj.cols()
+              && ((fc.adj.array() == 0) == (adj.array() == 0)).all()
+              && fc.AAs.nonZeros() == AAs.nonZeros()
+              && std::equal(AAs.outerIndexPtr(),
+                            AAs.outerIndexPtr() + AAs.outerSize() + 1,
+                            fc.AAs.outerIndexPtr())
+              && std::equal(AAs.innerIndexPtr(),
+                            AAs.innerIndexPtr() + AAs.nonZeros(),
+                            fc.AAs.innerIndexPtr());
+
+  if (!hit) {
+    fc.d = d;
+    fc.n = n;
+    fc.adj = adj;
+    fc.chol.analyzePattern(AAs);
+  }
 
-    X.insertBack(i, j) = it.value();
+  fc.AAs = AAs;
+  // Symmetric formations can make constraint rows redundant, i.e., A*A' is
+  // singular. A small shift gives the least-norm y instead of a zero pivot.
+  fc.chol.setShift(params_.shiftAAs);
+  fc.chol.factorize(fc.AAs);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::Workspace::resize(size_t N, size_t nx, size_t ny,
+                                Formulation f, bool anderson)
+{
+  if (this->N != N) {
+    for (auto * M : {&X, &Xold, &S, &Sold, &W, &H, &D, &V}) {
+      M->resize(N, N);
+    }
+    this->N = N;
+  }
+  x.resize(nx); Aty.resize(nx);
+  Ax.resize(ny); y.resize(ny); b.resize(ny);
+  if (anderson) { z.resize(2*N*N); Tz.resize(2*N*N); }
+
+  if (f == Formulation::Hermitian) {
+    const size_t M = N / 2;
+    if (Mesc != M) {
+      Z.resize(M, M); Zp.resize(M, M); Vc.resize(M, M);
+      esc = Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd>(M);
+      Mesc = M;
+    }
+  } else if (Nes != N) {
+    es = Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>(N);
+    Nes = N;
   }
 }
 
 // ----------------------------------------------------------------------------
 
-void Solver::admm(const SpMat& C, const SpMat& A, const SpMat& b, SpMat& X)
+void Solver::admm(const SpMat& C, const Constraints& A, const SpMat& b,
+                  Formulation f, Workspace& work, Iterate& X, Iterate& S,
+                  Stats& stats, Clock::time_point deadline, Telemetry* tel,
+                  const Scaling * scale)
 {
 
-  // cached operations
-  const SpMat As = A.adjoint(); // dual operator
-  Eigen::SimplicialCholesky<SpMat> AAs((A * As).pruned());
+  // n.b., buffers are only (re)allocated if the problem size changed
+  work.resize(X.rows(), A.cols(), A.rows(), f, params_.andersonMem > 0);
+  X.copyTo(work.X);
+  S.copyTo(work.S);
+  work.b = b;
+
+  // equilibrated: \tilde{X} = D^-1 X D^-1 and \tilde{S} = D S D
+  if (scale) {
+    work.X = scale->dXinv.asDiagonal() * work.X * scale->dXinv.asDiagonal();
+    work.S = scale->dX.asDiagonal() * work.S * scale->dX.asDiagonal();
+  }
+
+  double mu = params_.mu;
+  // n.b., residuals are measured in the original scaling
+  const double bnorm = 1 + ((scale) ? work.b.cwiseProduct(scale->drinv).norm()
+                                    : work.b.norm());
+  const double Cnorm = 1 + ((scale) ? (scale->dXinv.asDiagonal() * C
+                                        * scale->dXinv.asDiagonal()).norm()
+                                    : C.norm());
+  const double thr = params_.thrSparseZero;
 
-  // initialize intermediate variables
-  SpMat Xold;
-  SpMat S(X.rows(), X.cols());
-  SpMat y(b.rows(), 1);
+  Anderson anderson(params_.andersonMem);
+
+  stats = Stats();
 
   //
   // ADMM Iterations
   //
 
   for (size_t i=0; i<params_.maxItr; ++i) {
+    stats.iterations = i + 1;
+
+    IterationTelemetry it;
+    it.mu = mu;
+    Clock::time_point t0;
+    if (tel) t0 = std::chrono::steady_clock::now();
 
     // update y
     {
-      const SpMat D = C - S - params_.mu * X;
-      SpMat Dvec; vectorize(D, Dvec);
-      const SpMat e = A * Dvec + params_.mu * b;
-      y = AAs.solve(e); // AAs \ e
+      work.D = - work.S - mu * work.X;
+      work.D += C;
+      vectorize(work.D, work.x, f);
+      A.apply(work.x, work.Ax, work.ns);
+      work.Ax += mu * work.b;
+      A.solveNormal(work.Ax, work.y); // AAs \ e
     }
+    if (tel) it.tY = telemetry::elapsedMs(t0);
+    if (tel) t0 = std::chrono::steady_clock::now();
 
     // update S
-    SpMat W;
     {
-      const SpMat d = (As * y).pruned(1, params_.thrSparseZero);
-      SpMat dmat(X.rows(), X.cols()); unvectorize(d, dmat);
-      const SpMat WW = C - dmat - params_.mu * X;
-      W = (WW + SpMat(WW.transpose())) / 2.0;
-    }
-
-    // determine index where positive evals start
-    Eigen::SelfAdjointEigenSolver<SpMat> es(W);
-    size_t k = 0;
-    for (size_t i=0; i<W.rows(); ++i) {
-      if (es.eigenvalues()(i) > params_.epsEig) {
-        k = i;
-        break;
+      A.applyAdjoint(work.y, work.Aty, work.ns);
+      work.Aty = (work.Aty.array().abs() > thr).select(work.Aty, 0.0);
+      unvectorize(work.Aty, work.D, f);
+      work.H = work.D.transpose();
+      work.H += work.D;
+      work.H *= 0.5;
+
+      // over-relaxation: mix A'y with its value at dual feasibility, C - S
+      if (params_.alpha != 1.0) {
+        work.H *= params_.alpha;
+        work.H -= (1 - params_.alpha) * work.S;
+        work.H += (1 - params_.alpha) * C;
       }
+
+      work.W = - work.H - mu * work.X;
+      work.W += C;
     }
-    const size_t idxPosStart = W.rows() - k;
 
-    // remove non-positive modes
-    const Eigen::MatrixXd V = es.eigenvectors().rightCols(idxPosStart);
-    const Eigen::MatrixXd D = es.eigenvalues().tail(idxPosStart).asDiagonal();
-    S = (V * D * V.transpose()).sparseView(1, params_.thrSparseZero);
+    if (tel) it.tUpdate = telemetry::elapsedMs(t0);
+    if (tel) t0 = std::chrono::steady_clock::now();
+
+    // project onto PSD cone, i.e., remove non-positive modes
+    work.Sold = work.S;
+    projectPSD(work.W, work.S, f, work);
+
+    if (tel) it.tEig = telemetry::elapsedMs(t0);
+    if (tel) t0 = std::chrono::steady_clock::now();
 
     // update X
-    Xold = X;
-    X = (S - W) / params_.mu;
-
-    // check stop criteria --- difference in X
-    const double diffX = (X - Xold).cwiseAbs().sum();
-    if (diffX < params_.thresh) break;
-
-    // check problem specific stop criteria --- trace value of \bar{A}
-    const auto Abar = X.bottomRightCorner(X.rows()/2, X.cols()/2);
-    const double Etr = Abar.rows(); // expected trace value (d*m)
-    double tr = 0;
-    for (size_t k=0; k<Abar.rows(); ++k) tr += Abar.coeff(k,k);
+    work.Xold = work.X;
+    work.X = (work.S - work.W) / mu;
+
+    // extrapolate from previous iterates, with (X, S) as the state
+    if (params_.andersonMem > 0) {
+      const size_t N = work.N;
+      Eigen::Map<Eigen::MatrixXd>(work.z.data(), N, N) = work.Xold;
+      Eigen::Map<Eigen::MatrixXd>(work.z.data() + N*N, N, N) = work.Sold;
+      Eigen::Map<Eigen::MatrixXd>(work.Tz.data(), N, N) = work.X;
+      Eigen::Map<Eigen::MatrixXd>(work.Tz.data() + N*N, N, N) = work.S;
+
+      work.z = anderson.step(work.z, work.Tz);
+      work.X = Eigen::Map<const Eigen::MatrixXd>(work.z.data(), N, N);
+      work.S = Eigen::Map<const Eigen::MatrixXd>(work.z.data() + N*N, N, N);
+      work.X = (work.X.array().abs() > thr).select(work.X, 0.0);
+      work.S = (work.S.array().abs() > thr).select(work.S, 0.0);
+    }
+
+    if (tel) it.tUpdate += telemetry::elapsedMs(t0);
+    if (tel) t0 = std::chrono::steady_clock::now();
+
+    // primal and dual residuals
+    {
+      vectorize(work.X, work.x, f);
+      A.apply(work.x, work.Ax, work.ns);
+      work.Ax -= work.b;
+      if (scale) work.Ax.array() *= scale->drinv.array();
+      stats.primalRes = work.Ax.norm() / bnorm;
+      work.D = - work.H - work.S;
+      work.D += C;
+      if (scale) {
+        work.D = scale->dXinv.asDiagonal() * work.D
+                  * scale->dXinv.asDiagonal();
+      }
+      stats.dualRes = work.D.norm() / Cnorm;
+      stats.mu = mu;
+    }
+
+    // trace value of \bar{A}
+    const size_t dm = work.N / 2;
+    const double Etr = dm; // expected trace value (d*m)
+    const double tr = (scale)
+        ? work.X.diagonal().tail(dm).dot(scale->dX.tail(dm).cwiseAbs2())
+        : work.X.bottomRightCorner(dm, dm).trace();
     double trPercentErr = (tr - Etr) / Etr;
-    if (trPercentErr < params_.threshTr) break;
+
+    bool stop = false;
+    if (params_.residualStop) {
+      stop = stats.primalRes < params_.epsPrimal
+              && stats.dualRes < params_.epsDual;
+    } else {
+      // check stop criteria --- difference in X
+      work.D = work.X - work.Xold;
+      if (scale) {
+        work.D = scale->dX.asDiagonal() * work.D * scale->dX.asDiagonal();
+      }
+      const double diffX = work.D.cwiseAbs().sum();
+
+      // check problem specific stop criteria --- trace value of \bar{A}
+      stop = (diffX < params_.thresh) || (trPercentErr < params_.threshTr);
+    }
+
+    if (tel) {
+      it.tStop = telemetry::elapsedMs(t0);
+      it.primalRes = stats.primalRes;
+      it.dualRes = stats.dualRes;
+      it.trErr = trPercentErr;
+      tel->iterations.push_back(it);
+    }
+
+    if (stop) break;
+
+    // out of time: settle for the projection of the current iterate
+    if (Clock::now() >= deadline) {
+      stats.deadline = true;
+      break;
+    }
+
+    // someone else has what they need, e.g., another member of a portfolio
+    if (cancel_ && cancel_->load(std::memory_order_relaxed)) {
+      stats.cancelled = true;
+      break;
+    }
+
+    // balance primal and dual residuals
+    if (params_.adaptiveMu) {
+      const double muPrev = mu;
+      if (stats.primalRes > params_.muBalance * stats.dualRes) {
+        mu = std::min(mu * params_.muFactor, params_.muMax);
+      } else if (stats.dualRes > params_.muBalance * stats.primalRes) {
+        mu = std::max(mu / params_.muFactor, params_.muMin);
+      }
+
+      // the fixed-point map changed, so the history is no longer valid
+      if (mu != muPrev) anderson.reset();
+    }
   }
 
+  stats.andersonRestarts = anderson.restarts();
+
   //
   // Project soln to ensure graph constraints are satisfied (set S=0)
   //
 
-  const SpMat D = C - params_.mu * X;
-  SpMat Dvec; vectorize(D, Dvec);
-  const SpMat e = A * Dvec + params_.mu * b;
-  y = AAs.solve(e); // AAs \ e
+  const auto tproj = std::chrono::steady_clock::now();
+
+  work.D = - mu * work.X;
+  work.D += C;
+  vectorize(work.D, work.x, f);
+  A.apply(work.x, work.Ax, work.ns);
+  work.Ax += mu * work.b;
+  A.solveNormal(work.Ax, work.y); // AAs \ e
+
+  A.applyAdjoint(work.y, work.Aty, work.ns);
+  work.Aty = (work.Aty.array().abs() > thr).select(work.Aty, 0.0);
+  unvectorize(work.Aty, work.D, f);
+  work.W = - work.D - mu * work.X;
+  work.W += C;
+  work.H = work.W.transpose();
+  work.W += work.H;
+  work.W *= 0.5;
+
+  work.X = (- work.W) / mu;
+
+  // back to the original scaling
+  if (scale) {
+    work.X = scale->dX.asDiagonal() * work.X * scale->dX.asDiagonal();
+    work.S = scale->dXinv.asDiagonal() * work.S * scale->dXinv.asDiagonal();
+  }
+
+  X.assign(work.X, params_.denseFill);
+  S.assign(work.S, params_.denseFill);
+
+  if (tel) tel->tProject = telemetry::elapsedMs(tproj);
+
+  // quality of the returned solution
+  const size_t dm = work.N / 2;
+  const Eigen::MatrixXd Abar = work.X.bottomRightCorner(dm, dm);
+  stats.trErr = std::abs(Abar.trace() - dm) / dm;
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> es(Abar,
+                                                    Eigen::EigenvaluesOnly);
+  stats.eigMargin = es.eigenvalues()(0);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::projectPSD(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                        Formulation f, Workspace& work)
+{
+  bool done = false;
+
+  if (params_.eigPartial) {
+    // only the positive modes are needed. Try to get them iteratively.
+    const size_t maxModes = params_.eigPartialMaxFrac * W.rows();
+    Eigen::VectorXd evals;
+    Eigen::MatrixXd V;
+    if (lanczosAbove(W, params_.epsEig, maxModes, params_.eigPartialTol,
+                      evals, V)) {
+      S.noalias() = V * evals.asDiagonal() * V.transpose();
+      done = true;
+    }
+  }
+
+  if (!done && f == Formulation::Hermitian) {
+    projectPSDHermitian(W, S, work);
+  } else if (!done) {
+    projectPSDDense(W, S, work.es, work.V);
+  }
+
+  // drop numerical noise, as storing S sparse used to
+  S = (S.array().abs() > params_.thrSparseZero).select(S, 0.0);
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::projectPSDDense(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>& es,
+                        Eigen::MatrixXd& V)
+{
+  // determine index where positive evals start
+  es.compute(W);
+  size_t k = W.rows(); // n.b., no positive modes if none is found
+  for (int i=0; i<W.rows(); ++i) {
+    if (es.eigenvalues()(i) > params_.epsEig) {
+      k = i;
+      break;
+    }
+  }
+  const size_t idxPosStart = W.rows() - k;
+
+  // remove non-positive modes, i.e., S = V_+ D_+ V_+'
+  const auto Vp = es.eigenvectors().rightCols(idxPosStart);
+  V.leftCols(idxPosStart) = Vp * es.eigenvalues().tail(idxPosStart).asDiagonal();
+  S.noalias() = V.leftCols(idxPosStart) * Vp.transpose();
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::projectPSDHermitian(const Eigen::MatrixXd& W, Eigen::MatrixXd& S,
+                                  Workspace& work)
+{
+  // W is the real representation of a Hermitian matrix Z, with 2x2 blocks
+  // [a b; -b a] for Z_kl = a - ib. Its eigenvalues are those of Z, twice.
+  const size_t M = W.rows() / 2;
+  for (size_t l=0; l<M; ++l) {
+    for (size_t k=0; k<M; ++k) {
+      work.Z(k,l) = std::complex<double>(W(2*k,2*l), W(2*k+1,2*l));
+    }
+  }
+
+  // determine index where positive evals start
+  work.esc.compute(work.Z);
+  size_t k = M; // n.b., no positive modes if none is found
+  for (size_t i=0; i<M; ++i) {
+    if (work.esc.eigenvalues()(i) > params_.epsEig) {
+      k = i;
+      break;
+    }
+  }
+  const size_t idxPosStart = M - k;
+
+  // remove non-positive modes
+  const auto Vp = work.esc.eigenvectors().rightCols(idxPosStart);
+  work.Vc.leftCols(idxPosStart) = Vp * work.esc.eigenvalues().tail(idxPosStart)
+                          .cast<std::complex<double>>().asDiagonal();
+  work.Zp.noalias() = work.Vc.leftCols(idxPosStart) * Vp.adjoint();
+
+  for (size_t l=0; l<M; ++l) {
+    for (size_t k=0; k<M; ++k) {
+      S(2*k,2*l) = S(2*k+1,2*l+1) = work.Zp(k,l).real();
+      S(2*k+1,2*l) = work.Zp(k,l).imag();
+      S(2*k,2*l+1) = -work.Zp(k,l).imag();
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void Solver::reduceHermitian(size_t N, size_t rows,
+                              std::vector<Eigen::Triplet<double>>& Acoeffs,
+                              std::vector<Eigen::Triplet<double>>& bcoeffs,
+                              SpMat& A, SpMat& b)
+{
+  const size_t M = N / 2;
+
+  //
+  // Substitute each [X]_ij by the parameter of Z it is an entry of
+  //
+
+  for (auto& t : Acoeffs) {
+    size_t i = t.col() % N, j = t.col() / N;
+    size_t k = i / 2, l = j / 2;
+    if (k > l) { std::swap(i, j); std::swap(k, l); }
+    const bool re = (i % 2 == j % 2);
+
+    if (k == l) {
+      // Im of a diagonal entry is zero, i.e., this term vanishes
+      const double v = (re) ? t.value() / std::sqrt(2.0) : 0.0;
+      t = Eigen::Triplet<double>(t.row(), hermsel(k, k, 0), v);
+    } else if (re) {
+      t = Eigen::Triplet<double>(t.row(), hermsel(k, l, 0), t.value() / 2.0);
+    } else {
+      // [X]_{2k+1,2l} = Im Z_kl and [X]_{2k,2l+1} = -Im Z_kl
+      const double s = (i % 2 == 1) ? 0.5 : -0.5;
+      t = Eigen::Triplet<double>(t.row(), hermsel(k, l, 1), s * t.value());
+    }
+  }
+
+  Eigen::SparseMatrix<double, Eigen::RowMajor> Ar(rows, M*M);
+  Ar.setFromTriplets(Acoeffs.begin(), Acoeffs.end());
+  Ar.prune(1.0, std::numeric_limits<double>::epsilon());
 
-  const SpMat d = (As * y).pruned(1, params_.thrSparseZero);
-  SpMat dmat(X.rows(), X.cols()); unvectorize(d, dmat);
-  const SpMat WW = C - dmat - params_.mu * X;
-  const SpMat W = (WW + SpMat(WW.transpose())) / 2.0;
+  Eigen::VectorXd bd = Eigen::VectorXd::Zero(rows);
+  for (const auto& t : bcoeffs) bd(t.row()) += t.value();
+
+  //
+  // Drop rows that vanished (e.g., a-a = 0 of X_11) or are repeated (the
+  // a and -b of each 2x2 block are constrained twice in the real form).
+  //
+
+  std::set<std::vector<std::pair<int, double>>> seen;
+  std::vector<Eigen::Triplet<double>> Ared, bred;
+  Ared.reserve(Ar.nonZeros());
+  size_t r = 0;
+  for (size_t i=0; i<rows; ++i) {
+    if (Ar.row(i).nonZeros() == 0) continue;
+
+    // rows equal up to scale, with b scaled the same
+    std::vector<std::pair<int, double>> key;
+    double v0 = 0;
+    for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(Ar, i);
+          it; ++it) {
+      if (v0 == 0) v0 = it.value();
+      key.emplace_back(it.col(), it.value() / v0);
+    }
+    key.emplace_back(-1, bd(i) / v0);
+    if (!seen.insert(key).second) continue;
+
+    for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(Ar, i);
+          it; ++it) {
+      Ared.emplace_back(r, it.col(), it.value());
+    }
+    if (bd(i) != 0) bred.emplace_back(r, 0, bd(i));
+    r++;
+  }
 
-  X = (- W) / params_.mu;
+  A.resize(r, M*M);
+  A.setFromTriplets(Ared.begin(), Ared.end());
+  b.resize(r, 1);
+  b.setFromTriplets(bred.begin(), bred.end());
 }
 
 // ----------------------------------------------------------------------------
 
-void Solver::parse(size_t d, size_t m, size_t n,
+template <int D>
+void Solver::parse(size_t dim, size_t m, size_t n,
                       const Eigen::MatrixXd& adj, const Eigen::MatrixXd& Q,
-                      SpMat& C, SpMat& A, SpMat& b, SpMat& X)
+                      SpMat& C, SpMat& A, SpMat& b, SpMat& X,
+                      std::vector<Constraints::GraphRow> * graph)
 {
+  // n.b., a compile-time constant when specialized, so that index arithmetic
+  // and the d == 2 structure branches fold away.
+  const size_t d = (D == Eigen::Dynamic) ? dim : D;
+
+  // n.b., the 2D structure and symmetry are implied by the Hermitian
+  // formulation, and symmetry by svec.
+  const Formulation f = formulation(d);
+  const bool svec = (f == Formulation::SVec);
+  const bool herm = (f == Formulation::Hermitian);
+
   //
   // Preallocate number of non-zeros
   //
@@ -371,7 +1442,7 @@ void Solver::parse(size_t d, size_t m, size_t n,
 
   // structure constraints for each gain matrix block
   const size_t nrA_X22_struct =
-  (d == 2) ?
+  (d == 2 && !herm) ?
       0.5*m*(m+1)*(2+2)       // structure constraints: A_ij = [a b; -b a]
                               // 0.5*m*(m+1): each blk, including A_ii blks
     - m                       // don't count -b elem on A_ii (below diag)
@@ -393,8 +1464,8 @@ void Solver::parse(size_t d, size_t m, size_t n,
       d*m;                    // the sum of each [X_22]_ii == d*m*destrace
   const size_t nrb_X22_trace = 1;
 
-  // X must be symmetric: [X]_ij == [X]_ji
-  const size_t nrA_X_sym =
+  // X must be symmetric: [X]_ij == [X]_ji (implied by svec)
+  const size_t nrA_X_sym = (svec || herm) ? 0 :
       2 * d*m * (2*d*m-1);    //
   const size_t nrb_X_sym = 0;
 
@@ -422,7 +1493,7 @@ void Solver::parse(size_t d, size_t m, size_t n,
   }
 
   std::vector<Eigen::Triplet<double>> Acoeffs, bcoeffs;
-  Acoeffs.reserve(nrA);
+  Acoeffs.reserve((graph) ? nrA - nrA_X22_adjmat : nrA);
   bcoeffs.reserve(nrb);
 
   size_t itrr = 0; // which row of \mathbf{A} should nz val be in?
@@ -516,7 +1587,7 @@ void Solver::parse(size_t d, size_t m, size_t n,
   // Build constraints for block X_22 = \bar{A}
   //
 
-  if (d == 2) {
+  if (d == 2 && !herm) {
     // structure constraints A_ij = [a b; -b a]
     for (size_t i=0; i<m; ++i) {
       for (size_t j=i; j<m; ++j) {
@@ -569,23 +1640,19 @@ void Solver::parse(size_t d, size_t m, size_t n,
         // we leverage the structure constraint [a b; -b a] and only
         // create explicit constraints for [A_ij]_11 and [A_ij]_12.
 
-        // two constraint rows are created in \mathbf{A}
-        const size_t itrr1 = itrr;
-        const size_t itrr2 = itrr + 1;
-
-        // Constraint on [A_ij]_11
-        const size_t ii1 = blksel(d, i, 0); // skip first dm rows
-        const size_t jj1 = blksel(d, j, 0); // and cols for X_22
-        const Eigen::MatrixXd QQ1 = Q.transpose().col(jj1) * Q.row(ii1);
-
-        Eigen::MatrixXd QQ2;
-        if (d == 2) {
-          // Constraint on [A_ij]_12
-          const size_t ii2 = blksel(d, i, 1); // skip first dm rows
-          const size_t jj2 = blksel(d, j, 0); // and cols for X_22
-          QQ2 = Q.transpose().col(jj2) * Q.row(ii2);
+        // matrix-free: only remember which rows of Q define the constraint
+        if (graph) {
+          graph->emplace_back(blksel(d, i, 0), blksel(d, j, 0));
+          if (d == 2) graph->emplace_back(blksel(d, i, 1), blksel(d, j, 0));
+          continue;
         }
 
+        // Constraint on [A_ij]_r1, r = 1..d, i.e., q_{j,1}' \bar{A} q_{i,r}
+        // with q the rows of Q. These d rows are created in \mathbf{A}.
+        const size_t jj1 = blksel(d, j, 0);
+        const Eigen::Matrix<double, D, Eigen::Dynamic> Qi =
+                                          Q.middleRows(blksel(d, i, 0), d);
+
         // Note how the linear transformation using the orthogonal complement Q
         // leaks signal into each element of the gain matrix \bar{A}.
         for (size_t ki=0; ki<d*m; ++ki) {
@@ -595,8 +1662,10 @@ void Solver::parse(size_t d, size_t m, size_t n,
             const size_t jj = d*m + kj; // and cols for X_22
             const size_t itrc = vecsel(2*d*m, 2*d*m, ii, jj);
 
-            Acoeffs.emplace_back(itrr1, itrc, QQ1(ki,kj));
-            if (d == 2) Acoeffs.emplace_back(itrr2, itrc, QQ2(ki,kj));
+            const Eigen::Matrix<double, D, 1> coeffs = Q(jj1, ki) * Qi.col(kj);
+            for (size_t r=0; r<d; ++r) {
+              Acoeffs.emplace_back(itrr + r, itrc, coeffs(r));
+            }
           }
         }
 
@@ -640,7 +1709,7 @@ void Solver::parse(size_t d, size_t m, size_t n,
   //
 
   // symmetric entries should be equal
-  for (size_t i=0; i<2*d*m; ++i) {
+  for (size_t i=0; i<2*d*m && !svec && !herm; ++i) {
     for (size_t j=i+1; j<2*d*m; ++j) {
 
       const size_t itrc1 = vecsel(2*d*m, 2*d*m, i, j);
@@ -670,23 +1739,27 @@ void Solver::parse(size_t d, size_t m, size_t n,
   // Prepare sparse matrices for ADMM
   //
 
-  C.resize(2*d*m, 2*d*m);
-  C.reserve(Eigen::VectorXi::Constant(d*m,1)); // reserve 1 nz per column of X_11
-  for (size_t i=0; i<d*m; ++i) C.insert(i,i) = 1; // make [I 0; 0 0]
+  initialize(d*m, C, X);
 
-  // initialize decision variable to something fairly close
-  X.resize(2*d*m, 2*d*m); // [I I; I I]
-  X.reserve(Eigen::VectorXi::Constant(2*d*m,2)); // reserve 2 nz per column
-  for (size_t i=0; i<d*m; ++i) {
-    X.insert(i,i) = 1;
-    X.insert(d*m+i,i) = 1;
-  }
-  for (size_t i=d*m; i<2*d*m; ++i) {
-    X.insert(i,i) = 1;
-    X.insert(i-d*m,i) = 1;
+  if (herm) {
+    reduceHermitian(2*d*m, itrr, Acoeffs, bcoeffs, A, b);
+    return;
   }
 
-  A.resize(itrr, X.size());
+  if (svec) {
+    // A row acts on symmetric X only through its symmetric part, i.e.,
+    // <A_r, X> = svec(sym(A_r))'svec(X). Coefficients on mirrored entries of
+    // X are summed when the triplets are set.
+    for (auto& t : Acoeffs) {
+      const size_t i = t.col() % (2*d*m);
+      const size_t j = t.col() / (2*d*m);
+      const double s = (i == j) ? 1.0 : 1.0 / std::sqrt(2.0);
+      t = Eigen::Triplet<double>(t.row(), svecsel(i, j), s * t.value());
+    }
+    A.resize(itrr, 2*d*m*(2*d*m+1)/2);
+  } else {
+    A.resize(itrr, X.size());
+  }
   A.setFromTriplets(Acoeffs.begin(), Acoeffs.end());
 
   b.resize(itrr, 1);
@@ -6,11 +6,12 @@ import sys, time
 import rospy
 import numpy as np
 
-from std_msgs.msg import UInt8MultiArray, MultiArrayDimension
+from std_msgs.msg import UInt8MultiArray, Float32MultiArray, MultiArrayDimension
 from geometry_msgs.msg import Point, PoseStamped
 from visualization_msgs.msg import Marker, MarkerArray
 from snapstack_msgs.msg import QuadFlightMode
 from aclswarm_msgs.msg import Formation
+from aclswarm_msgs.srv import FormationGains
 from behavior_selector.srv import MissionModeChange
 
 from aclswarm.control import createGainMatrix
@@ -31,6 +32,8 @@ class Operator:
 
         # Load desired formations
         self.send_gains = rospy.get_param('~send_gains', False)
+        self.gain_server = rospy.get_param('~gain_server', '')
+        self.gain_server_timeout = rospy.get_param('~gain_server_timeout', 1.0)
         formation_group = rospy.get_param('~formation_group')
         self.formations = rospy.get_param('~{}'.format(formation_group))
         self.manageAdjmat()
@@ -181,12 +184,18 @@ class Operator:
         msg.adjmat.layout.dim[1].size = adjmat.shape[1]
         msg.adjmat.layout.dim[1].stride = adjmat.shape[1]
 
+        # register the formation with the gain server, so that vehicles
+        # fetch its gains instead of each solving for them
+        gains = self.requestGains(formation, msg)
+
         # should we include formation gains in our message?
         if self.send_gains:
 
             # pre-calculated gains may have been provided, but not required.
             # Store the gains so we do not need to redo work.
-            if 'gains' not in formation:
+            if 'gains' not in formation and gains is not None:
+                formation['gains'] = gains
+            elif 'gains' not in formation:
                 formation['gains'] = createGainMatrix(adjmat, pts, method='original')
 
                 # # Print gain matrix for easy copying into formations.yaml
@@ -198,7 +207,7 @@ class Operator:
 
             # pack up the gains into the message
             gains = np.array(A, dtype=np.float32)
-            msg.gains = UInt8MultiArray()
+            msg.gains = Float32MultiArray()
             msg.gains.data = gains.flatten().tolist()
             msg.gains.layout.dim.append(MultiArrayDimension())
             msg.gains.layout.dim.append(MultiArrayDimension())
@@ -212,6 +221,58 @@ class Operator:
         msg.header.stamp = rospy.Time.now()
         return msg
 
+    def requestGains(self, formation, msg):
+        """Request formation gains from the gain server
+        The server designs the gains of each formation once and keys them
+        by a hash, which is sent along with the formation. Vehicles then
+        fetch the gains by hash, or solve locally if the server is down.
+        Returns the 3nx3n gains, or None if the server is unavailable.
+        """
+
+        if not self.gain_server:
+            return None
+
+        try:
+            rospy.wait_for_service(self.gain_server,
+                                    timeout=self.gain_server_timeout)
+            getGains = rospy.ServiceProxy(self.gain_server, FormationGains)
+
+            # already registered, unless the server evicted (or lost) it since
+            res = None
+            if 'gains_hash' in formation:
+                res = getGains(hash=formation['gains_hash'])
+
+            # (re-)register the formation
+            if res is None or not res.success:
+                res = getGains(hash=0, points=msg.points, adjmat=msg.adjmat)
+        except (rospy.ROSException, rospy.ServiceException) as e:
+            rospy.logwarn('Gain server unavailable, vehicles will '
+                          'solve for gains: {}'.format(e))
+            return None
+
+        if not res.success:
+            formation.pop('gains_hash', None)
+            return None
+
+        formation['gains_hash'] = res.hash
+        msg.gains_hash = res.hash
+
+        # expand the diagonal and edge blocks (see FormationGains.srv)
+        adjmat = np.array(msg.adjmat.data).reshape(len(msg.points), -1)
+        n = adjmat.shape[0]
+        blocks = np.array(res.gains.data).reshape(-1, 3, 3)
+        edges = [(i, j) for i in range(n) for j in range(i+1, n) if adjmat[i,j]]
+        if blocks.shape[0] != n + len(edges):
+            return None
+
+        A = np.zeros((3*n, 3*n))
+        for i in range(n):
+            A[3*i:3*i+3, 3*i:3*i+3] = blocks[i]
+        for k, (i, j) in enumerate(edges):
+            A[3*i:3*i+3, 3*j:3*j+3] = blocks[n+k]
+            A[3*j:3*j+3, 3*i:3*i+3] = blocks[n+k].T
+        return A
+
     def poseCb(self, msg, i):
         # n.b., this is only used when sending centralized assignments
         # n.b., we are using the index of this vehicle in the /vehs list
@@ -5,17 +5,17 @@
  * @date 29 Jan 2020
  */
 
+#include <limits>
+#include <stdexcept>
+
 #include "aclswarm/admm.h"
 
 namespace acl {
 namespace aclswarm {
 
-ADMM::ADMM(const size_t n)
+ADMM::ADMM()
 {
   ADMMGainDesign3D_initialize();
-
-  // allocate memory for a 2D array of dynamic size. Used to store ADMM result.
-  emxInit_real_T(&Aopt_, 2);
 }
 
 // ----------------------------------------------------------------------------
@@ -23,31 +23,61 @@ ADMM::ADMM(const size_t n)
 ADMM::~ADMM()
 {
   // clean up our mess
-  emxFree_real_T(&Aopt_);
   ADMMGainDesign3D_terminate();
 }
 
 // ----------------------------------------------------------------------------
 
-GainMat ADMM::calculateFormationGains(const PtsMat& p, const AdjMat& adjmat)
+Eigen::MatrixXd ADMM::solve(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj, double deadline,
+                        Quality& quality)
+{
+  if (deadline > 0) {
+    throw std::invalid_argument("The codegen gain design has no deadline");
+  }
+
+  // residuals and eigenvalues are internal to the generated code
+  static constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+  quality = Quality();
+  quality.trErr = quality.primalRes = quality.dualRes = nan;
+  quality.eigMargin = nan;
+
+  return calculateFormationGains(pts, adj);
+}
+
+// ----------------------------------------------------------------------------
+
+Eigen::MatrixXd ADMM::calculateFormationGains(
+                        const Eigen::Matrix<double, 3, Eigen::Dynamic>& pts,
+                        const Eigen::MatrixXd& adj)
 {
-  // copy the incoming memory so we can use it. Not super efficient.
-  Eigen::Matrix<double, 3, Eigen::Dynamic> pp = p.transpose();
-  Eigen::MatrixXd a = adjmat.cast<double>();
+  const int n = pts.cols();
+
+  // Map the memory into the MATLAB emx structure for use. The inputs are
+  // only read, and both are column-major like MATLAB, so nothing is copied.
+  emxArray_real_T * Qs = emxCreateWrapper_real_T(
+                              const_cast<double *>(pts.data()), 3, n);
+  emxArray_real_T * a = emxCreateWrapper_real_T(
+                              const_cast<double *>(adj.data()), n, n);
 
-  // Map the memory into the MATLAB emx structure for use
-  emxArray_real_T * Qs = emxCreateWrapper_real_T(pp.data(), pp.rows(), pp.cols());
-  emxArray_real_T * adj = emxCreateWrapper_real_T(a.data(), a.rows(), a.cols());
+  // The output is written in place, since its capacity already fits 3nx3n
+  A_.resize(3*n, 3*n);
+  emxArray_real_T * Aopt = emxCreateWrapper_real_T(A_.data(), 3*n, 3*n);
 
-  ADMMGainDesign3D(Qs, adj, Aopt_);
+  ADMMGainDesign3D(Qs, a, Aopt);
 
-  emxFree_real_T(&adj);
-  emxFree_real_T(&Qs);
+  // n.b., only if MATLAB had to grow the array (it then owns the data)
+  if (Aopt->data != A_.data()) {
+    A_ = Eigen::Map<Eigen::MatrixXd>(Aopt->data, Aopt->size[0], Aopt->size[1]);
+  }
 
-  Eigen::Map<GainMat> A(Aopt_->data, Aopt_->size[0], Aopt_->size[1]);
+  emxDestroyArray_real_T(Aopt);
+  emxDestroyArray_real_T(a);
+  emxDestroyArray_real_T(Qs);
 
   // kill values that are smaller in magnitude than eps
-  return (1e-10 < A.array().abs()).select(A, 0.0);
+  return (1e-10 < A_.array().abs()).select(A_, 0.0);
 }
 
 // ----------------------------------------------------------------------------
@@ -58,8 +88,8 @@ void ADMM::emxPrint(emxArray_real_T * emx)
 {
   std::cout << emx->size[0] << "x" << emx->size[1] << std::endl;
 
-  for (size_t i=0; i<emx->size[0]; ++i) {
-   for (size_t j=0; j<emx->size[1]; ++j) {
+  for (int i=0; i<emx->size[0]; ++i) {
+   for (int j=0; j<emx->size[1]; ++j) {
      std::cout << std::setprecision(4) << std::setfill(' ') << std::setw(10)
        << emx->data[i + emx->size[0] * j] << " ";
    }
@@ -7,8 +7,15 @@
 
 #include "aclswarm/coordination_ros.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <eigen_conversions/eigen_msg.h>
 
+#include <admm/portfolio_solver.h>
+#include <admm/solver.h>
+#include "aclswarm/admm.h"
+
 namespace acl {
 namespace aclswarm {
 
@@ -109,13 +116,31 @@ void CoordinationROS::spin()
       formation_ = newformation_;
 
       // We only need to solve gains if they were not already provided
-      if (formation_->gains.size() == 0) {
-        // solve for gains
+      if (formation_->gains.empty()) {
+        // the gain server solves each formation once for the whole swarm
         auto timestart = ros::Time::now();
-        formation_->gains = admm_->solve(formation_->qdes.transpose(),
-                                          formation_->adjmat.cast<double>());
-        ROS_INFO_STREAM("Generated gains in " <<
+        if (requestGains(*formation_)) {
+          ROS_INFO_STREAM("Received gains from the gain server in " <<
                           (ros::Time::now() - timestart).toSec() << " secs.");
+        } else {
+          // solve for gains
+          admm::GainDesign::Quality quality;
+          formation_->gains = admm_->solveBlocks(formation_->qdes.transpose(),
+                                            formation_->adjmat.cast<double>(),
+                                            admm_deadline_, quality);
+          ROS_INFO_STREAM("Generated gains (" << admm_->name() << ") in " <<
+                            (ros::Time::now() - timestart).toSec() << " secs.");
+          if (!quality.converged) {
+            ROS_WARN_STREAM("Gain design hit the " << admm_deadline_
+                            << " ms deadline: trace err " << quality.trErr
+                            << ", primal " << quality.primalRes << ", dual "
+                            << quality.dualRes << ", eig margin "
+                            << quality.eigMargin);
+          }
+          if (!quality.cacheHit && quality.eigMargin <= 0) {
+            ROS_WARN("Designed gains may not stabilize the formation");
+          }
+        }
       }
 
       // let the controller know about the new formation
@@ -169,11 +194,70 @@ void CoordinationROS::init()
   bool verbose;
   nhp_.param<bool>("verbose", verbose, false);
 
+  std::string backend;
+  nhp_.param<std::string>("admm/backend", backend, "solver");
+
+  admm::Params admmParams;
+  nhp_.param<bool>("admm/warm_start", admmParams.warmStart, false);
+  nhp_.param<bool>("admm/matrix_free", admmParams.matrixFree, false);
+  nhp_.param<bool>("admm/null_space", admmParams.nullSpace, false);
+  nhp_.param<bool>("admm/eig_partial", admmParams.eigPartial, false);
+  nhp_.param<bool>("admm/closed_form", admmParams.closedForm, true);
+  nhp_.param<double>("admm/deadline", admm_deadline_, 0.0);
+  nhp_.param<std::string>("gain_server", gain_server_, "/gain_server/gains");
+  nhp_.param<double>("gain_server_timeout", gain_server_timeout_, 0.5);
+  nhp_.param<bool>("admm/parallel", admmParams.parallel, false);
+  int cacheSize;
+  nhp_.param<int>("admm/cache_size", cacheSize, 0);
+  admmParams.cacheSize = std::max(cacheSize, 0);
+
+  bool telemetry;
+  nhp_.param<bool>("admm/telemetry", telemetry, false);
+  if (telemetry) {
+    admmParams.telemetry = [](const admm::Telemetry& tel) {
+      double tY = 0, tEig = 0, tUpdate = 0, tStop = 0;
+      for (const auto& it : tel.iterations) {
+        tY += it.tY; tEig += it.tEig; tUpdate += it.tUpdate; tStop += it.tStop;
+        ROS_DEBUG_STREAM("ADMM " << tel.d << "D itr: y " << it.tY
+                          << " eig " << it.tEig << " update " << it.tUpdate
+                          << " stop " << it.tStop << " ms, primal "
+                          << it.primalRes << " dual " << it.dualRes
+                          << " trerr " << it.trErr << " mu " << it.mu);
+      }
+      const auto& last = (tel.iterations.empty()) ? admm::IterationTelemetry()
+                                                  : tel.iterations.back();
+      ROS_INFO_STREAM("ADMM " << tel.d << "D (n = " << tel.n << ", "
+                      << tel.rowsA << " constraints, nnz(A) = " << tel.nnzA
+                      << "): " << tel.tTotal << " ms total, parse "
+                      << tel.tParse << " ms, factorize " << tel.tFactorize
+                      << " ms, " << tel.iterations.size() << " itr (y " << tY
+                      << " ms, eig " << tEig << " ms, update " << tUpdate
+                      << " ms, stop " << tStop << " ms), project "
+                      << tel.tProject << " ms; primal " << last.primalRes
+                      << " dual " << last.dualRes << " trerr " << last.trErr);
+    };
+  }
+
   //
   // Instantiate module objects for tasks
   //
 
-  admm_.reset(new admm::Solver());
+  if (backend == "codegen") {
+    if (admm_deadline_ > 0) {
+      ROS_WARN("The codegen gain design has no deadline, ignoring it");
+      admm_deadline_ = 0;
+    }
+    admm_.reset(new ADMM);
+  } else if (backend == "portfolio") {
+    admm_.reset(new admm::PortfolioSolver(
+                          admm::PortfolioSolver::configurations(admmParams)));
+  } else {
+    if (backend != "solver") {
+      ROS_WARN_STREAM("Unknown gain design backend '" << backend
+                      << "', using 'solver'");
+    }
+    admm_.reset(new admm::Solver(admmParams));
+  }
   controller_.reset(new DistCntrl(vehid_, n_));
   auctioneer_.reset(new Auctioneer(vehid_, n_, verbose));
 
@@ -224,11 +308,16 @@ void CoordinationROS::formationCb(const aclswarm_msgs::FormationConstPtr& msg)
     newformation_->qdes.row(i) = qrow;
   }
 
+  // the operator may have registered the formation with the gain server
+  newformation_->gainsHash = msg->gains_hash;
+
   // if no gains are sent, this will be empty---causing the solver to run
   if (msg->gains.layout.dim.size() == 2) {
-    newformation_->gains = utils::decodeGainMat(msg->gains);
+    newformation_->gains = admm::BlockGainMat::fromDense(
+                                    utils::decodeGainMat(msg->gains),
+                                    newformation_->adjmat.cast<double>());
   } else {
-    newformation_->gains = Eigen::MatrixXd();
+    newformation_->gains = admm::BlockGainMat();
   }
 
   formationsent_ = msg->header.stamp;
@@ -389,6 +478,58 @@ void CoordinationROS::sendZeroControl()
 
 // ----------------------------------------------------------------------------
 
+bool CoordinationROS::requestGains(DistCntrl::Formation& formation)
+{
+  // the operator did not register this formation at the gain server
+  if (gain_server_.empty() || formation.gainsHash == 0) return false;
+
+  // n.b., a persistent connection is dropped if the server restarts
+  if (!gain_client_.isValid()) {
+    gain_client_ = nh_.serviceClient<aclswarm_msgs::FormationGains>(
+                                                          gain_server_, true);
+  }
+
+  // n.b., only the wait for the server needs a bound: the call is served
+  // from its cache (see below)
+  if (!gain_client_.waitForExistence(ros::Duration(gain_server_timeout_))) {
+    ROS_WARN_STREAM("Gain server '" << gain_server_ << "' unavailable, "
+                    "solving locally");
+    return false;
+  }
+
+  // Only the hash is sent, so the server answers from its cache and never
+  // solves while this vehicle waits. If it was evicted, we solve locally.
+  aclswarm_msgs::FormationGains srv;
+  srv.request.hash = formation.gainsHash;
+
+  if (!gain_client_.call(srv) || !srv.response.success) {
+    ROS_WARN("Gain server request failed, solving locally");
+    return false;
+  }
+
+  // the blocks are in storage order (see aclswarm_msgs/FormationGains)
+  const auto& gains = srv.response.gains;
+  admm::BlockGainMat G(formation.adjmat.cast<double>());
+  if (gains.layout.dim.size() != 3 || gains.layout.dim[0].size != G.numBlocks()
+        || gains.data.size() < gains.layout.data_offset + 9*G.numBlocks()) {
+    ROS_WARN("Gain server sent gains of another graph, solving locally");
+    return false;
+  }
+
+  for (size_t k=0; k<G.numBlocks(); ++k) {
+    const float * B = &gains.data[gains.layout.data_offset + 9*k];
+    for (size_t i=0; i<3; ++i) {
+      for (size_t j=0; j<3; ++j) G.stored(k)(i,j) = B[3*i + j];
+    }
+  }
+
+  formation.gainsHash = srv.response.hash;
+  formation.gains = std::move(G);
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+
 bool CoordinationROS::connectToNeighbors()
 {
   bool was_changed = false; // indicates if nbr was added
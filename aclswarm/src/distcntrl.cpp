@@ -61,7 +61,7 @@ Eigen::Vector3d DistCntrl::compute(const PtsMat& q_veh, const Eigen::Vector3d ve
     // is there an edge between my formation point and this other one?
     if (formation_->adjmat(i, j)) {
       // locate the relevant block in the gain matrix ("formation space").
-      const auto Aij = formation_->gains.block<3, 3>(3*i, 3*j);
+      const Eigen::Matrix3d Aij = formation_->gains.block(i, j);
 
       // calculate the relative translation btwn my and this formation point
       const Eigen::Vector3d qij = q.row(j) - q.row(i);
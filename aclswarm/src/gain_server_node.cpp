@@ -0,0 +1,20 @@
+/**
+ * @file gain_server_node.cpp
+ * @brief Entry point for gain server ROS node
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include <ros/ros.h>
+
+#include "aclswarm/gain_server_ros.h"
+
+int main(int argc, char *argv[])
+{
+  ros::init(argc, argv, "gain_server");
+  ros::NodeHandle nhtopics("");
+  ros::NodeHandle nhparams("~");
+  acl::aclswarm::GainServerROS node(nhtopics, nhparams);
+  ros::spin();
+  return 0;
+}
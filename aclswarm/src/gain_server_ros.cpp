@@ -0,0 +1,193 @@
+/**
+ * @file gain_server_ros.cpp
+ * @brief ROS wrapper for gain design shared by the swarm
+ * @author agent <agent@local>
+ * @date 17 Oct 2026
+ */
+
+#include "aclswarm/gain_server_ros.h"
+
+#include <algorithm>
+
+#include <eigen_conversions/eigen_msg.h>
+
+#include <admm/portfolio_solver.h>
+#include <admm/solver.h>
+
+namespace acl {
+namespace aclswarm {
+
+/**
+ * @brief      Converts block gains to msg, i.e., the stored 3x3 blocks in
+ *             storage order (see admm::BlockGainMat), each row-major
+ *
+ * @param[in]  G     The block gains
+ *
+ * @return     The gains multiarray (blocks x 3 x 3)
+ */
+static std_msgs::Float32MultiArray encodeBlockGainMat(
+                                                const admm::BlockGainMat& G)
+{
+  std_msgs::Float32MultiArray msg;
+  msg.layout.dim.resize(3);
+  msg.layout.dim[0].label = "blocks";
+  msg.layout.dim[0].size = G.numBlocks();
+  msg.layout.dim[0].stride = 9 * G.numBlocks();
+  msg.layout.dim[1].label = "rows";
+  msg.layout.dim[1].size = 3;
+  msg.layout.dim[1].stride = 9;
+  msg.layout.dim[2].label = "cols";
+  msg.layout.dim[2].size = 3;
+  msg.layout.dim[2].stride = 3;
+
+  msg.data.reserve(9 * G.numBlocks());
+  for (size_t k=0; k<G.numBlocks(); ++k) {
+    const Eigen::Matrix3d& B = G.stored(k);
+    for (size_t i=0; i<3; ++i) {
+      for (size_t j=0; j<3; ++j) msg.data.push_back(B(i,j));
+    }
+  }
+
+  return msg;
+}
+
+// ----------------------------------------------------------------------------
+
+GainServerROS::GainServerROS(const ros::NodeHandle nh,
+                              const ros::NodeHandle nhp)
+: nh_(nh), nhp_(nhp)
+{
+
+  //
+  // Load parameters
+  //
+
+  int cacheSize;
+  nhp_.param<int>("cache_size", cacheSize, 32);
+  cache_size_ = std::max(cacheSize, 1);
+
+  admm::Params admmParams;
+  nhp_.param<bool>("admm/matrix_free", admmParams.matrixFree, false);
+  nhp_.param<bool>("admm/null_space", admmParams.nullSpace, false);
+  nhp_.param<bool>("admm/eig_partial", admmParams.eigPartial, false);
+  nhp_.param<bool>("admm/closed_form", admmParams.closedForm, true);
+  nhp_.param<bool>("admm/parallel", admmParams.parallel, true);
+  nhp_.param<double>("admm/deadline", admm_deadline_, 0.0);
+
+  // n.b., gains of transformed formations come from the solver's own cache
+  int solverCacheSize;
+  nhp_.param<int>("admm/cache_size", solverCacheSize, 16);
+  admmParams.cacheSize = std::max(solverCacheSize, 0);
+
+  // race a few solver configurations, e.g., on a multi-core operator machine
+  bool portfolio;
+  nhp_.param<bool>("admm/portfolio", portfolio, false);
+  if (portfolio) {
+    admm_.reset(new admm::PortfolioSolver(
+                          admm::PortfolioSolver::configurations(admmParams)));
+  } else {
+    admm_.reset(new admm::Solver(admmParams));
+  }
+
+  //
+  // ROS services
+  //
+
+  srv_gains_ = nhp_.advertiseService("gains", &GainServerROS::gainsCb, this);
+}
+
+// ----------------------------------------------------------------------------
+// Private Methods
+// ----------------------------------------------------------------------------
+
+const admm::BlockGainMat * GainServerROS::lookup(uint64_t hash)
+{
+  const auto it = cache_.find(hash);
+  if (it == cache_.end()) return nullptr;
+
+  // most recently used
+  order_.splice(order_.begin(), order_, it->second.second);
+  return &it->second.first;
+}
+
+// ----------------------------------------------------------------------------
+
+void GainServerROS::insert(uint64_t hash, const admm::BlockGainMat& gains)
+{
+  // evict the least recently used
+  if (cache_.size() >= cache_size_) {
+    cache_.erase(order_.back());
+    order_.pop_back();
+  }
+
+  order_.push_front(hash);
+  cache_[hash] = std::make_pair(gains, order_.begin());
+}
+
+// ----------------------------------------------------------------------------
+
+bool GainServerROS::gainsCb(aclswarm_msgs::FormationGains::Request& req,
+                            aclswarm_msgs::FormationGains::Response& res)
+{
+  res.success = false;
+  res.hash = req.hash;
+
+  // a known formation does not need to be sent (or decoded)
+  admm::BlockGainMat A;
+  const admm::BlockGainMat * gains = (req.hash != 0) ? lookup(req.hash)
+                                                     : nullptr;
+
+  if (gains == nullptr) {
+    if (req.points.empty()) {
+      ROS_WARN_STREAM("Formation " << req.hash << " is unknown");
+      return true;
+    }
+
+    const AdjMat adjmat = utils::decodeAdjMat(req.adjmat);
+    const size_t n = req.points.size();
+    if (adjmat.rows() != n || adjmat.cols() != n) {
+      ROS_ERROR_STREAM("Formation of " << n << " points with a "
+                        << adjmat.rows() << "x" << adjmat.cols() << " graph");
+      return true;
+    }
+
+    PtsMat qdes = PtsMat::Zero(n, 3);
+    for (size_t i=0; i<n; ++i) {
+      Eigen::Vector3d qrow;
+      tf::pointMsgToEigen(req.points[i], qrow);
+      qdes.row(i) = qrow;
+    }
+
+    res.hash = utils::hashFormation(qdes, adjmat);
+    gains = lookup(res.hash);
+
+    if (gains == nullptr) {
+      auto timestart = ros::Time::now();
+      admm::GainDesign::Quality quality;
+      A = admm_->solveBlocks(qdes.transpose(), adjmat.cast<double>(),
+                              admm_deadline_, quality);
+      ROS_INFO_STREAM("Generated gains of formation " << res.hash << " (n = "
+                      << n << ") in " << (ros::Time::now() - timestart).toSec()
+                      << " secs.");
+      if (!quality.cacheHit && quality.eigMargin <= 0) {
+        ROS_WARN("Designed gains may not stabilize the formation");
+      }
+
+      // n.b., gains cut short by the deadline are not reused
+      if (quality.converged) {
+        insert(res.hash, A);
+      } else {
+        ROS_WARN_STREAM("Gain design hit the " << admm_deadline_
+                        << " ms deadline: trace err " << quality.trErr);
+      }
+      gains = &A;
+    }
+  }
+
+  res.gains = encodeBlockGainMat(*gains);
+  res.success = true;
+  return true;
+}
+
+} // ns aclswarm
+} // ns acl
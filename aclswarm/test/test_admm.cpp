@@ -1,7 +1,11 @@
+#include <thread>
+
 #include <gtest/gtest.h>
 
 #include <eigen3/unsupported/Eigen/KroneckerProduct>
 
+#include <admm/batch_solver.h>
+#include <admm/portfolio_solver.h>
 #include <admm/solver.h>
 #include <aclswarm/utils.h>
 
@@ -228,6 +232,817 @@ TEST(ADMMTest, fixedTraceSparse)
 
 // ----------------------------------------------------------------------------
 
+TEST(ADMMTest, closedFormFullyConnected)
+{
+  static constexpr size_t n = 15;
+  admm::Solver admm;
+  admm::Params params;
+  params.closedForm = false;
+  admm::Solver admmIterative(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Ai = admmIterative.solve(p.transpose(), adj.cast<double>());
+
+  EXPECT_NEAR((A - Ai).norm(), 0, 1e-10);
+  EXPECT_EQ(admm.stats2d().iterations, 0);
+  EXPECT_EQ(admm.stats1d().iterations, 0);
+  EXPECT_GT(admmIterative.stats2d().iterations, 0);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, planarAltitudeConsensus)
+{
+  static constexpr size_t n = 5;
+  admm::Solver admm;
+
+  // flat at z = 0, i.e., the altitude gains only need to keep consensus
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,2) = adj(2,0) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+  p.col(2).setZero();
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+
+  Eigen::MatrixXd Az(n, n);
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<n; ++j) Az(i,j) = A(3*i+2, 3*j+2);
+  }
+
+  EXPECT_NEAR((Az * Eigen::VectorXd::Ones(n)).norm(), 0, 1e-8);
+  EXPECT_NEAR(Az.trace(), -(n - 1.0), 1e-8);
+  EXPECT_NEAR(Az(0,2), 0, 1e-8);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, warmStartSparse)
+{
+  static constexpr size_t n = 20;
+  admm::Params params;
+  params.warmStart = true;
+  admm::Solver admm(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  // first solve is cold, second is seeded with a slightly different formation
+  admm.solve(p.transpose(), adj.cast<double>());
+  p += PtsMat::Random(n, 3) * 0.1;
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+
+  static constexpr double d = 3;
+  static constexpr double m = n - 2; // reduced dimension of problem
+  static constexpr double expectedTrace = -d * m;
+
+  EXPECT_NEAR(A.trace(), expectedTrace, 1e-8);
+  EXPECT_NEAR((A.block<3,3>(3*0, 3*5).norm()), 0, 1e-8);
+  EXPECT_NEAR((A.block<3,3>(3*3, 3*15).norm()), 0, 1e-8);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, denseIteratesWarmStart)
+{
+  static constexpr size_t n = 20;
+  admm::Params params;
+  params.warmStart = true;
+  params.denseFill = 2; // never dense, i.e., always sparse
+  admm::Solver admmSparse(params);
+  params.denseFill = 0; // always dense
+  admm::Solver admmDense(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  // the second solve is seeded with the iterates stored by the first
+  for (size_t k=0; k<2; ++k) {
+    GainMat As = admmSparse.solve(p.transpose(), adj.cast<double>());
+    GainMat Ad = admmDense.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((As - Ad).norm(), 0, 1e-10);
+    p += PtsMat::Random(n, 3) * 0.1;
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, equilibratedSparse)
+{
+  admm::Solver admm;
+  admm::Params params;
+  params.equilibrate = true;
+  admm::Solver admmRuiz(params);
+  params.formulation = admm::Formulation::Hermitian;
+  admm::Solver admmRuizHerm(params);
+
+  for (size_t n : {9, 20}) {
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    adj(0,6) = adj(6,0) = 0;
+    adj(2,4) = adj(4,2) = 0;
+    adj(5,7) = adj(7,5) = 0;
+    PtsMat p = PtsMat::Random(n, 3) * 5;
+
+    // Only the Hermitian coefficients (1/2 off the diagonal) are scaled.
+    // Vec has a unit coefficient on every index of X, so it is left as is.
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat Ar = admmRuiz.solve(p.transpose(), adj.cast<double>());
+    GainMat Arh = admmRuizHerm.solve(p.transpose(), adj.cast<double>());
+    EXPECT_EQ(A, Ar);
+
+    // n.b., the solution is unscaled before it is returned
+    static constexpr double d = 3;
+    const double m = n - 2; // reduced dimension of problem
+    EXPECT_NEAR(Arh.trace(), -d * m, 1e-8);
+    EXPECT_NEAR((Arh.block<3,3>(3*0, 3*6).norm()), 0, 1e-8);
+    EXPECT_NEAR((Arh.block<3,3>(3*2, 3*4).norm()), 0, 1e-8);
+    EXPECT_NEAR((Arh.block<3,3>(3*5, 3*7).norm()), 0, 1e-8);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, matrixFreeSparse)
+{
+  static constexpr size_t n = 20;
+  admm::Solver admm;
+  admm::Params params;
+  params.matrixFree = true;
+  admm::Solver admmMatrixFree(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  adj(7,8) = adj(8,7) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Amf = admmMatrixFree.solve(p.transpose(), adj.cast<double>());
+
+  EXPECT_NEAR((A - Amf).norm(), 0, 1e-8);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, nullSpaceSparse)
+{
+  admm::Solver admm;
+  admm::Params params;
+  params.nullSpace = true;
+  admm::Solver admmNullSpace(params);
+
+  for (size_t n : {9, 20}) {
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    adj(0,5) = adj(5,0) = 0;
+    adj(3,8) = adj(8,3) = 0;
+    adj(2,7) = adj(7,2) = 0;
+    adj(1,6) = adj(6,1) = 0;
+    PtsMat p = PtsMat::Random(n, 3) * 5;
+
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat Ans = admmNullSpace.solve(p.transpose(), adj.cast<double>());
+
+    EXPECT_NEAR((A - Ans).norm(), 0, 1e-6);
+    EXPECT_NEAR((Ans.block<3,3>(3*0, 3*5).norm()), 0, 1e-8);
+    EXPECT_NEAR((Ans.block<3,3>(3*3, 3*8).norm()), 0, 1e-8);
+    EXPECT_NEAR((Ans.block<3,3>(3*2, 3*7).norm()), 0, 1e-8);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, lowRankSparse)
+{
+  static constexpr size_t n = 9;
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=i+2; j<n; ++j) {
+      if ((i + j) % 3 == 0 && !(i == 0 && j == n-1)) adj(i,j) = adj(j,i) = 0;
+    }
+  }
+
+  // n.b., not from Random, which would change the formations of later tests
+  PtsMat p(n, 3);
+  for (size_t i=0; i<n; ++i) {
+    p(i,0) = 5*std::cos(0.7*i) + 0.3*i;
+    p(i,1) = 5*std::sin(1.3*i);
+    p(i,2) = i % 3;
+  }
+
+  // ADMM to a tight tolerance, i.e., the optimum of the SDP
+  admm::Params params;
+  params.nullSpace = true;
+  params.residualStop = true;
+  params.maxItr = 20000;
+  params.epsPrimal = params.epsDual = 1e-7;
+  admm::Solver admm(params);
+  admm::Solver::Quality quality;
+  admm.solve(p.transpose(), adj.cast<double>(), 0, quality);
+
+  params = admm::Params();
+  params.lowRank = true;
+  admm::Solver admmLowRank(params);
+  admm::Solver::Quality qualityLowRank;
+  GainMat A = admmLowRank.solve(p.transpose(), adj.cast<double>(), 0,
+                                qualityLowRank);
+
+  EXPECT_TRUE(qualityLowRank.converged);
+  EXPECT_LT(admmLowRank.stats2d().dualRes, 1e-6);
+  EXPECT_NEAR(qualityLowRank.eigMargin, quality.eigMargin, 1e-5);
+  EXPECT_NEAR(admmLowRank.stats1d().eigMargin, admm.stats1d().eigMargin, 1e-5);
+
+  // feasible regardless of convergence
+  EXPECT_NEAR(qualityLowRank.trErr, 0, 1e-8);
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<n; ++j) {
+      if (i == j || adj(i,j)) continue;
+      EXPECT_NEAR((A.block<3,3>(3*i, 3*j).norm()), 0, 1e-8);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, partialEigSparse)
+{
+  static constexpr size_t n = 20;
+  admm::Solver admm;
+  admm::Params params;
+  params.eigPartial = true;
+  params.eigPartialMaxFrac = 1.0; // never fall back to dense eigensolver
+  admm::Solver admmPartialEig(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  adj(7,8) = adj(8,7) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Ape = admmPartialEig.solve(p.transpose(), adj.cast<double>());
+
+  EXPECT_NEAR((A - Ape).norm(), 0, 1e-6);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, parallelSparse)
+{
+  static constexpr size_t n = 20;
+  admm::Solver admm;
+  admm::Params params;
+  params.parallel = true;
+  params.numThreads = 2;
+  admm::Solver admmParallel(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  adj(7,8) = adj(8,7) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Ap = admmParallel.solve(p.transpose(), adj.cast<double>());
+
+  EXPECT_EQ(A, Ap);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, gainCacheTransformed)
+{
+  static constexpr size_t n = 10;
+  admm::Params params;
+  params.cacheSize = 4;
+  admm::Solver admm(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,7) = adj(7,3) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  // translated, rotated about z and scaled copy of the formation
+  const double th = 0.7, s = 2.5;
+  Eigen::Matrix3d R;
+  R << std::cos(th), -std::sin(th), 0, std::sin(th), std::cos(th), 0, 0, 0, 1;
+  PtsMat pt = ((s * p * R.transpose()).rowwise()
+                              + Eigen::RowVector3d(1, -2, 3)).eval();
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat At = admm.solve(pt.transpose(), adj.cast<double>());
+
+  EXPECT_EQ(admm.gainCache().hits(), 1);
+
+  // n.b., only the diagonal and edge blocks are cached (see BlockGainMat)
+  const GainMat Ab = admm::BlockGainMat::fromDense(A, adj.cast<double>())
+                                                                .toDense();
+  EXPECT_EQ(Ab, At);
+
+  // the cached gains have the transformed formation in their kernel
+  Eigen::MatrixXd ptT = pt.transpose();
+  Eigen::VectorXd qt = Eigen::Map<Eigen::VectorXd>(ptT.data(), 3*n);
+  EXPECT_NEAR((At * qt).norm(), 0, 1e-6);
+
+  // a different graph is a different formation
+  adj(1,2) = adj(2,1) = 0;
+  admm.solve(pt.transpose(), adj.cast<double>());
+  EXPECT_EQ(admm.gainCache().hits(), 1);
+  EXPECT_EQ(admm.gainCache().size(), 2);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, gainCacheFlatAltitude)
+{
+  static constexpr size_t n = 6;
+  admm::Params params;
+  params.cacheSize = 4;
+  admm::Solver admm(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,3) = adj(3,0) = 0;
+  PtsMat p(n, 3);
+  p << 0, 0, 1,  4, 0, 1,  6, 3, 1,  4, 6, 1,  0, 6, 1,  -2, 3, 1;
+
+  // the same flat formation at another altitude
+  PtsMat pz = p;
+  pz.col(2).array() += 7.5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Az = admm.solve(pz.transpose(), adj.cast<double>());
+
+  EXPECT_EQ(admm.gainCache().hits(), 1);
+
+  // n.b., only the diagonal and edge blocks are cached (see BlockGainMat)
+  const GainMat Ab = admm::BlockGainMat::fromDense(A, adj.cast<double>())
+                                                                .toDense();
+  EXPECT_EQ(Ab, Az);
+
+  Eigen::MatrixXd pzT = pz.transpose();
+  Eigen::VectorXd qz = Eigen::Map<Eigen::VectorXd>(pzT.data(), 3*n);
+  EXPECT_NEAR((Az * qz).norm(), 0, 1e-6);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, blockGainsSparse)
+{
+  static constexpr size_t n = 10;
+  admm::Solver admm;
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,7) = adj(7,3) = 0;
+  adj(2,8) = adj(8,2) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  admm::BlockGainMat Ab = admm.solveBlocks(p.transpose(), adj.cast<double>());
+
+  EXPECT_EQ(Ab.n(), n);
+  EXPECT_EQ(Ab.numBlocks(), n + (adj.cast<int>().sum() / 2));
+  EXPECT_NEAR((A - Ab.toDense()).norm(), 0, 1e-12);
+
+  for (size_t i=0; i<n; ++i) {
+    for (size_t j=0; j<n; ++j) {
+      const Eigen::Matrix3d Aij = A.block<3,3>(3*i, 3*j);
+      EXPECT_NEAR((Aij - Ab.block(i, j)).norm(), 0, 1e-12);
+    }
+  }
+
+  // the block gains are cached as they are
+  admm::Params params;
+  params.cacheSize = 4;
+  admm::Solver cached(params);
+  admm::BlockGainMat Ab1 = cached.solveBlocks(p.transpose(), adj.cast<double>());
+  admm::BlockGainMat Ab2 = cached.solveBlocks(p.transpose(), adj.cast<double>());
+  EXPECT_EQ(cached.gainCache().hits(), 1);
+  EXPECT_EQ(Ab1.toDense(), Ab2.toDense());
+  EXPECT_EQ(Ab1.toDense(), Ab.toDense());
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, svecMatchesVec)
+{
+  admm::Solver admm;
+  admm::Params params;
+  params.formulation = admm::Formulation::SVec;
+  admm::Solver admmSvec(params);
+
+  // four agent square, fully connected and non-complete
+  {
+    static constexpr size_t n = 4;
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    PtsMat p = PtsMat::Zero(n, 3);
+    p(0,0) = 0.0; p(0,1) = 0.0; p(0,2) = 2.5;
+    p(1,0) = 2.0; p(1,1) = 0.0; p(1,2) = 3.5;
+    p(2,0) = 2.0; p(2,1) = 2.0; p(2,2) = 4.5;
+    p(3,0) = 0.0; p(3,1) = 2.0; p(3,2) = 1.5;
+
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat As = admmSvec.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - As).norm(), 0, 1e-8);
+
+    adj(0,2) = 0; adj(2,0) = 0;
+    adj(1,3) = 0; adj(3,1) = 0;
+    A = admm.solve(p.transpose(), adj.cast<double>());
+    As = admmSvec.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - As).norm(), 0, 1e-8);
+  }
+
+  // random sparse formations
+  for (size_t n : {9, 20}) {
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    adj(0,6) = adj(6,0) = 0;
+    adj(2,4) = adj(4,2) = 0;
+    adj(5,7) = adj(7,5) = 0;
+    PtsMat p = PtsMat::Random(n, 3) * 5;
+
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat As = admmSvec.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - As).norm(), 0, 1e-8);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, hermitianMatchesVec)
+{
+  admm::Solver admm;
+  admm::Params params;
+  params.formulation = admm::Formulation::Hermitian;
+  admm::Solver admmHerm(params);
+
+  // four agent square, fully connected and non-complete
+  {
+    static constexpr size_t n = 4;
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    PtsMat p = PtsMat::Zero(n, 3);
+    p(0,0) = 0.0; p(0,1) = 0.0; p(0,2) = 2.5;
+    p(1,0) = 2.0; p(1,1) = 0.0; p(1,2) = 3.5;
+    p(2,0) = 2.0; p(2,1) = 2.0; p(2,2) = 4.5;
+    p(3,0) = 0.0; p(3,1) = 2.0; p(3,2) = 1.5;
+
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat Ah = admmHerm.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - Ah).norm(), 0, 1e-8);
+
+    adj(0,2) = 0; adj(2,0) = 0;
+    adj(1,3) = 0; adj(3,1) = 0;
+    A = admm.solve(p.transpose(), adj.cast<double>());
+    Ah = admmHerm.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - Ah).norm(), 0, 1e-8);
+  }
+
+  // random sparse formations
+  for (size_t n : {9, 20}) {
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    adj(0,6) = adj(6,0) = 0;
+    adj(2,4) = adj(4,2) = 0;
+    adj(5,7) = adj(7,5) = 0;
+    PtsMat p = PtsMat::Random(n, 3) * 5;
+
+    GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+    GainMat Ah = admmHerm.solve(p.transpose(), adj.cast<double>());
+    EXPECT_NEAR((A - Ah).norm(), 0, 1e-8);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, specializedParseMatchesDynamic)
+{
+  static constexpr size_t n = 6;
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,3) = adj(3,0) = 0;
+  adj(1,4) = adj(4,1) = 0;
+  PtsMat p(n, 3);
+  p << 0, 0, 1,  4, 0, 2,  6, 3, 1,  4, 6, 3,  0, 6, 1,  -2, 3, 2;
+
+  // parse<1> and parse<2> build the same SDP data as parse<Eigen::Dynamic>
+  for (auto f : {admm::Formulation::Vec, admm::Formulation::SVec,
+                  admm::Formulation::Hermitian}) {
+    for (bool matrixFree : {false, true}) {
+      admm::Params params;
+      params.formulation = f;
+      params.matrixFree = matrixFree;
+      admm::Solver specialized(params);
+      params.specializeDim = false;
+      admm::Solver dynamic(params);
+
+      admm::Solver::Problem ps, pd;
+      specialized.setup(p.transpose(), adj.cast<double>(), ps);
+      dynamic.setup(p.transpose(), adj.cast<double>(), pd);
+
+      for (auto sp : {std::make_pair(&ps.sp1d, &pd.sp1d),
+                      std::make_pair(&ps.sp2d, &pd.sp2d)}) {
+        EXPECT_EQ(Eigen::MatrixXd(sp.first->C), Eigen::MatrixXd(sp.second->C));
+        EXPECT_EQ(Eigen::MatrixXd(sp.first->A), Eigen::MatrixXd(sp.second->A));
+        EXPECT_EQ(Eigen::MatrixXd(sp.first->b), Eigen::MatrixXd(sp.second->b));
+        EXPECT_EQ(Eigen::MatrixXd(sp.first->X0),
+                  Eigen::MatrixXd(sp.second->X0));
+        EXPECT_EQ(sp.first->graph, sp.second->graph);
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, acceleratedResidualStop)
+{
+  static constexpr size_t n = 6;
+  admm::Params params;
+  params.residualStop = true;
+  params.maxItr = 1000;
+  admm::Solver admm(params);
+  params.andersonMem = 5;
+  admm::Solver admmAccel(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,3) = adj(3,0) = 0;
+  adj(1,4) = adj(4,1) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+  GainMat Aa = admmAccel.solve(p.transpose(), adj.cast<double>());
+
+  for (const auto* s : {&admm.stats2d(), &admm.stats1d(),
+                        &admmAccel.stats2d(), &admmAccel.stats1d()}) {
+    EXPECT_LT(s->iterations, params.maxItr);
+    EXPECT_LT(s->primalRes, params.epsPrimal);
+    EXPECT_LT(s->dualRes, params.epsDual);
+  }
+
+  EXPECT_LE(admmAccel.stats2d().iterations, admm.stats2d().iterations);
+  EXPECT_NEAR((A - Aa).norm() / A.norm(), 0, 1e-4);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, telemetry)
+{
+  static constexpr size_t n = 6;
+  std::vector<admm::Telemetry> telemetry;
+  admm::Params params;
+  params.telemetry = [&](const admm::Telemetry& tel) {
+    telemetry.push_back(tel);
+  };
+  admm::Solver admm(params);
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,3) = adj(3,0) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  admm.solve(p.transpose(), adj.cast<double>());
+
+  // one report per subproblem, 2D first
+  ASSERT_EQ(telemetry.size(), 2);
+  EXPECT_EQ(telemetry[0].d, 2);
+  EXPECT_EQ(telemetry[1].d, 1);
+  EXPECT_EQ(telemetry[0].iterations.size(), admm.stats2d().iterations);
+  EXPECT_EQ(telemetry[1].iterations.size(), admm.stats1d().iterations);
+
+  for (const auto& tel : telemetry) {
+    EXPECT_EQ(tel.n, n);
+    EXPECT_GT(tel.nnzA, 0);
+    EXPECT_GT(tel.rowsA, 0);
+    double tItr = 0;
+    for (const auto& it : tel.iterations) {
+      tItr += it.tY + it.tEig + it.tUpdate + it.tStop;
+    }
+    EXPECT_LE(tel.tParse + tel.tFactorize + tItr + tel.tProject, tel.tTotal);
+  }
+  EXPECT_DOUBLE_EQ(telemetry[0].iterations.back().primalRes,
+                   admm.stats2d().primalRes);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, deadlineSparse)
+{
+  static constexpr size_t n = 20;
+  admm::Solver admm;
+
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,15) = adj(15,3) = 0;
+  adj(7,8) = adj(8,7) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  admm::Solver::Quality quality;
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>(), 0, quality);
+  EXPECT_TRUE(quality.converged);
+  EXPECT_FALSE(quality.cacheHit);
+  EXPECT_GT(quality.eigMargin, 0);
+  EXPECT_NEAR(quality.trErr, 0, 1e-8);
+
+  // a deadline that has passed before the first iteration is done
+  GainMat Ad = admm.solve(p.transpose(), adj.cast<double>(), 1e-6, quality);
+  EXPECT_FALSE(quality.converged);
+  EXPECT_EQ(admm.stats2d().iterations, 1);
+  EXPECT_EQ(admm.stats1d().iterations, 1);
+  EXPECT_TRUE(admm.stats2d().deadline);
+
+  // the final projection still enforces the linear constraints
+  EXPECT_NEAR(quality.trErr, 0, 1e-8);
+  EXPECT_NEAR(Ad.trace(), A.trace(), 1e-8);
+  Eigen::Matrix<double, n, n> adjbar = (adj.cast<double>().array() - 1.0).cwiseAbs();
+  adjbar += -Eigen::Matrix<double, n, n>::Identity();
+  GainMat Asel = Eigen::kroneckerProduct(adjbar, Eigen::Matrix3d::Ones());
+  EXPECT_NEAR(Asel.cwiseProduct(Ad).cwiseAbs().sum(), 0, 1e-8);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, batchMatchesSerial)
+{
+  // a mix of sizes, complete and sparse graphs
+  std::vector<admm::BatchSolver::Problem> problems;
+  for (size_t k=0; k<8; ++k) {
+    const size_t n = 4 + 3*(k % 4);
+    AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+    if (k % 2) {
+      adj(0,2) = adj(2,0) = 0;
+      adj(1,3) = adj(3,1) = 0;
+    }
+    PtsMat p = PtsMat::Random(n, 3) * 5;
+    problems.push_back({p.transpose(), adj.cast<double>()});
+  }
+
+  admm::BatchSolver batch(admm::Params(), 3);
+  EXPECT_EQ(batch.numWorkers(), 3);
+
+  const auto gains = batch.solve(problems);
+  ASSERT_EQ(gains.size(), problems.size());
+
+  for (size_t k=0; k<problems.size(); ++k) {
+    admm::Solver admm;
+    GainMat A = admm.solve(problems[k].pts, problems[k].adj);
+    EXPECT_EQ((A - gains[k]).norm(), 0);
+  }
+
+  // deterministic, regardless of which worker solved what
+  const auto again = batch.solve(problems);
+  for (size_t k=0; k<problems.size(); ++k) {
+    EXPECT_EQ((again[k] - gains[k]).norm(), 0);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, cancelSparse)
+{
+  static constexpr size_t n = 12;
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,10) = adj(10,3) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  // a flag that is already set stops after the first iteration
+  std::atomic<bool> cancel(true);
+  admm::Solver admm;
+  admm.setCancelFlag(&cancel);
+
+  admm::Solver::Quality quality;
+  GainMat A = admm.solve(p.transpose(), adj.cast<double>(), 0, quality);
+  EXPECT_FALSE(quality.converged);
+  EXPECT_EQ(admm.stats2d().iterations, 1);
+  EXPECT_TRUE(admm.stats2d().cancelled);
+  EXPECT_FALSE(admm.stats2d().deadline);
+  EXPECT_NEAR(quality.trErr, 0, 1e-8);
+
+  cancel = false;
+  A = admm.solve(p.transpose(), adj.cast<double>(), 0, quality);
+  EXPECT_TRUE(quality.converged);
+  EXPECT_FALSE(admm.stats2d().cancelled);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, portfolioSparse)
+{
+  static constexpr size_t n = 12;
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,5) = adj(5,0) = 0;
+  adj(3,10) = adj(10,3) = 0;
+  adj(4,7) = adj(7,4) = 0;
+  PtsMat p = PtsMat::Random(n, 3) * 5;
+
+  admm::Params params;
+  params.residualStop = true;
+  params.maxItr = 1000;
+  params.epsPrimal = params.epsDual = 1e-6;
+  params.cacheSize = 4;
+  const auto configs = admm::PortfolioSolver::configurations(params);
+  EXPECT_EQ(configs.size(), 4);
+
+  admm::PortfolioSolver::Acceptance acceptance;
+  acceptance.maxPrimalRes = acceptance.maxDualRes = 1e-6;
+  admm::PortfolioSolver portfolio(configs, acceptance);
+  EXPECT_EQ(portfolio.size(), configs.size());
+
+  admm::GainDesign::Quality quality;
+  GainMat A = portfolio.solve(p.transpose(), adj.cast<double>(), 0, quality);
+  ASSERT_LT(portfolio.winner(), portfolio.size());
+  EXPECT_TRUE(quality.converged);
+  EXPECT_GT(quality.eigMargin, 0);
+  EXPECT_LE(quality.primalRes, 1e-6);
+
+  // the gains of the winning configuration on its own
+  admm::Solver admm(configs[portfolio.winner()]);
+  GainMat Aw = admm.solve(p.transpose(), adj.cast<double>());
+  EXPECT_NEAR((A - Aw).cwiseAbs().maxCoeff(), 0, 1e-10);
+
+  // the graph constraints hold
+  Eigen::Matrix<double, n, n> adjbar = (adj.cast<double>().array() - 1.0).cwiseAbs();
+  adjbar += -Eigen::Matrix<double, n, n>::Identity();
+  GainMat Asel = Eigen::kroneckerProduct(adjbar, Eigen::Matrix3d::Ones());
+  EXPECT_NEAR(Asel.cwiseProduct(A).cwiseAbs().sum(), 0, 1e-8);
+
+  // the winner's gains are cached for the whole portfolio
+  GainMat Ac = portfolio.solve(p.transpose(), adj.cast<double>(), 0, quality);
+  EXPECT_TRUE(quality.cacheHit);
+  EXPECT_NEAR((A - Ac).cwiseAbs().maxCoeff(), 0, 1e-8);
+
+  // the winner's blocks, with the default acceptance
+  admm::PortfolioSolver blocks(configs);
+  admm::BlockGainMat Ab = blocks.solveBlocks(p.transpose(), adj.cast<double>(),
+                                             0, quality);
+  EXPECT_FALSE(quality.cacheHit);
+  EXPECT_LE(quality.primalRes, 1e-6);
+  EXPECT_LE(quality.dualRes, 1e-6);
+  admm::Solver wb(configs[blocks.winner()]);
+  GainMat Awb = wb.solve(p.transpose(), adj.cast<double>());
+  EXPECT_NEAR((Ab.toDense() - Awb).cwiseAbs().maxCoeff(), 0, 1e-10);
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, sharedSetupSparse)
+{
+  static constexpr size_t n = 6;
+  AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+  adj(0,3) = adj(3,0) = 0;
+  adj(1,4) = adj(4,1) = 0;
+  PtsMat p(n, 3);
+  p << 0, 0, 1,  4, 0, 2,  6, 3, 1,  4, 6, 3,  0, 6, 1,  -2, 3, 2;
+
+  // solvers iterating concurrently on one setup match solving on their own
+  for (bool nullSpace : {false, true}) {
+    admm::Params params;
+    params.nullSpace = nullSpace;
+    admm::Solver a(params), b(params), c(params);
+    GainMat A = c.solve(p.transpose(), adj.cast<double>());
+
+    admm::Solver::Problem problem;
+    a.setup(p.transpose(), adj.cast<double>(), problem);
+
+    admm::GainDesign::Quality qa, qb;
+    Eigen::MatrixXd Aa, Ab;
+    std::thread t([&]() { Ab = b.solve(problem, 0, qb); });
+    Aa = a.solve(problem, 0, qa);
+    t.join();
+
+    EXPECT_EQ(Aa, A);
+    EXPECT_EQ(Ab, A);
+    EXPECT_TRUE(qa.converged && qb.converged);
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+TEST(ADMMTest, workspaceReuse)
+{
+  // one solver across sizes and formulations must match fresh solvers
+  for (auto f : {admm::Formulation::Vec, admm::Formulation::Hermitian}) {
+    admm::Params params;
+    params.formulation = f;
+    admm::Solver admm(params);
+
+    for (size_t n : {6, 9, 6}) {
+      AdjMat adj = AdjMat::Ones(n, n) - AdjMat::Identity(n, n);
+      adj(0,2) = adj(2,0) = 0;
+      adj(1,4) = adj(4,1) = 0;
+      PtsMat p = PtsMat::Random(n, 3) * 5;
+
+      admm::Solver fresh(params);
+      GainMat A = admm.solve(p.transpose(), adj.cast<double>());
+      GainMat Afresh = fresh.solve(p.transpose(), adj.cast<double>());
+      EXPECT_EQ((A - Afresh).norm(), 0);
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+
 int main(int argc, char **argv){
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();